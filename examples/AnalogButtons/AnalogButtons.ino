@@ -0,0 +1,67 @@
+/*
+ AnalogButtons.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to use several buttons connected to one
+ analog input by a resistor ladder.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect a 10k pullup resistor from PIN_ANALOG to VCC.
+ * Connect button1 from PIN_ANALOG to ground.
+ * Connect button2 from PIN_ANALOG by a 4.7k resistor to ground.
+ * Connect button3 from PIN_ANALOG by a 22k resistor to ground.
+
+ The values of the buttons depend on the resistors, print the values by
+ enabling PRINT_VALUES and adjust them in setup().
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include "OneButton.h"
+#include "OneButtonAnalogSet.h"
+
+#define PIN_ANALOG A0
+
+// #define PRINT_VALUES
+
+OneButton button1;
+OneButton button2;
+OneButton button3;
+
+OneButtonAnalogSet buttons(PIN_ANALOG);
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example with analog buttons.");
+
+  buttons.setIdleValue(1023);
+  buttons.addButton(&button1, 0);
+  buttons.addButton(&button2, 327);
+  buttons.addButton(&button3, 703);
+
+  button1.attachClick([]() {
+    Serial.println("button1 click.");
+  });
+  button2.attachClick([]() {
+    Serial.println("button2 click.");
+  });
+  button2.attachDoubleClick([]() {
+    Serial.println("button2 doubleclick.");
+  });
+  button3.attachLongPressStart([]() {
+    Serial.println("button3 long press start.");
+  });
+}  // setup()
+
+
+void loop() {
+#ifdef PRINT_VALUES
+  Serial.println(analogRead(PIN_ANALOG));
+  delay(200);
+#endif
+  buttons.tick();
+  delay(10);
+}  // loop()
+
+// End
@@ -0,0 +1,61 @@
+/*
+ AutoRepeat.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to use a held button as an accelerating
+ auto repeat like a volume control.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect a pushbutton to PIN_INPUT and ground.
+
+ A click increments the volume by 1. Holding the button down increments the
+ volume after 300 msecs with 5 repeats per second, getting faster up to 50
+ repeats per second after 2 seconds. The loop is slow on purpose so some
+ repeats are coalesced into one event.
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include "OneButton.h"
+
+#if defined(ARDUINO_AVR_UNO) || defined(ARDUINO_AVR_NANO_EVERY)
+#define PIN_INPUT 2
+
+#elif defined(ESP8266)
+#define PIN_INPUT D3
+
+#elif defined(ESP32)
+// Some boards have a BOOT switch using GPIO 0.
+#define PIN_INPUT 0
+
+#endif
+
+OneButton button(PIN_INPUT, true);
+long volume = 0;
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example with auto repeat.");
+
+  button.setPressMs(300);
+  button.setAutoRepeat(300, 200, 20, 2000);
+
+  button.attachClick([]() {
+    volume++;
+    Serial.println(volume);
+  });
+
+  button.attachDuringLongPress([]() {
+    volume += button.getRepeatCount();
+    Serial.println(volume);
+  });
+}  // setup()
+
+
+void loop() {
+  button.tick();
+  delay(30);
+}  // loop()
+
+// End
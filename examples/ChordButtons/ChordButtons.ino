@@ -0,0 +1,64 @@
+/*
+ ChordButtons.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to detect chords: buttons that are
+ pressed together.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect pushbuttons to the pins PIN_A, PIN_B and PIN_C and ground.
+
+ Every button reports its own clicks. Pressing A and B together calls the
+ A+B chord function, pressing all 3 buttons calls the A+B+C chord function.
+ The buttons of a detected chord report no clicks.
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include "OneButton.h"
+#include "OneButtonChord.h"
+
+#define PIN_A 2
+#define PIN_B 3
+#define PIN_C 4
+
+OneButton buttonA(PIN_A, true);
+OneButton buttonB(PIN_B, true);
+OneButton buttonC(PIN_C, true);
+
+OneButtonChord chord;
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example with chords.");
+
+  chord.addButton(&buttonA);
+  chord.addButton(&buttonB);
+  chord.addButton(&buttonC);
+
+  chord.addChord(0x03, []() {
+    Serial.println("chord A+B.");
+  });
+  chord.addChord(0x07, []() {
+    Serial.println("chord A+B+C.");
+  });
+
+  buttonA.attachClick([]() {
+    Serial.println("A click.");
+  });
+  buttonB.attachClick([]() {
+    Serial.println("B click.");
+  });
+  buttonC.attachClick([]() {
+    Serial.println("C click.");
+  });
+}  // setup()
+
+
+void loop() {
+  chord.tick();
+  delay(5);
+}  // loop()
+
+// End
@@ -0,0 +1,73 @@
+/*
+ ClickTiming.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to log the timing of clicks and long
+ presses by using functions receiving the event record.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect a pushbutton to PIN_INPUT and ground.
+
+ Every event prints the values captured when it was detected: the time, the
+ number of clicks, the duration of the press and the gaps between the
+ clicks. This helps to find good values for setClickMs() and setPressMs().
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include "OneButton.h"
+
+#if defined(ARDUINO_AVR_UNO) || defined(ARDUINO_AVR_NANO_EVERY)
+#define PIN_INPUT 2
+
+#elif defined(ESP8266)
+#define PIN_INPUT D3
+
+#elif defined(ESP32)
+// Some boards have a BOOT switch using GPIO 0.
+#define PIN_INPUT 0
+
+#endif
+
+OneButtonFull button(PIN_INPUT, true);
+
+const char *const eventNames[] = { "press", "click", "doubleclick", "multiclick", "longPressStart",
+                                   "duringLongPress", "longPressStop", "idle", "tentativeClick", "clickSuperseded" };
+
+
+// log all values of the event record.
+void logEvent(const OneButtonEvent &e) {
+  Serial.print(e.time);
+  Serial.print(" ");
+  Serial.print(eventNames[e.event]);
+  Serial.print(" clicks=");
+  Serial.print(e.clicks);
+  Serial.print(" duration=");
+  Serial.print(e.duration);
+  Serial.print(" gaps=");
+  for (uint8_t n = 0; (n + 1 < e.clicks) && (n < ONEBUTTONEVENT_GAPS); n++) {
+    Serial.print(e.gaps[n]);
+    Serial.print(" ");
+  }
+  Serial.println();
+}  // logEvent()
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example logging the timing of the events.");
+
+  button.attachClick(logEvent);
+  button.attachDoubleClick(logEvent);
+  button.attachMultiClick(logEvent);
+  button.attachLongPressStart(logEvent);
+  button.attachLongPressStop(logEvent);
+}  // setup()
+
+
+void loop() {
+  button.tick();
+  delay(10);
+}  // loop()
+
+// End
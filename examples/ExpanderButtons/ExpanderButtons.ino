@@ -0,0 +1,60 @@
+/*
+ ExpanderButtons.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to use 16 buttons on a MCP23017 I2C port expander.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect a MCP23017 with the address 0x20 to the I2C bus (SDA, SCL).
+ * Connect 16 pushbuttons to the pins GPA0...GPA7, GPB0...GPB7 and ground.
+
+ All 16 inputs are read with one bus transaction per tick instead of one
+ transaction per button. Only the buttons with a changed level and the
+ buttons with pending timers advance their state machines.
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include <Wire.h>
+#include "OneButton.h"
+#include "OneButtonExpander.h"
+
+OneButton buttons[16];
+OneButtonMCP23017 expander(0x20);
+OneButtonInputGroup group(&expander);
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example with 16 buttons on a MCP23017 port expander.");
+
+  Wire.begin();
+
+  for (intptr_t n = 0; n < 16; n++) {
+    buttons[n].attachClick([](void *p) {
+      Serial.print("Button ");
+      Serial.print((intptr_t)p);
+      Serial.println(" click.");
+    }, (void *)n);
+    buttons[n].attachLongPressStart([](void *p) {
+      Serial.print("Button ");
+      Serial.print((intptr_t)p);
+      Serial.println(" long press.");
+    }, (void *)n);
+    group.attach(n, &buttons[n]);
+  }
+
+  // the buttons connect the inputs with pullups to ground.
+  group.setActiveLowMask(0xFFFF);
+  if (!group.begin()) Serial.println("No MCP23017 found.");
+}  // setup()
+
+
+void loop() {
+  group.tick();
+
+  // other work can be done here.
+  delay(10);
+}  // loop()
+
+// End
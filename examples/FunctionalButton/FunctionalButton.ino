@@ -12,9 +12,9 @@ private:
   int value;
 public:
   explicit Button(uint8_t pin):button(pin) {
-    button.attachClick([](void *scope) { ((Button *) scope)->Clicked();}, this);
-    button.attachDoubleClick([](void *scope) { ((Button *) scope)->DoubleClicked();}, this);
-    button.attachLongPressStart([](void *scope) { ((Button *) scope)->LongPressed();}, this);
+    button.attachClick([this]() { Clicked(); });
+    button.attachDoubleClick([this]() { DoubleClicked(); });
+    button.attachLongPressStart([this]() { LongPressed(); });
   }
 
   void Clicked(){
@@ -0,0 +1,54 @@
+/*
+ GestureButton.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to select several commands by sequences
+ of short and long presses on one button.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect a pushbutton to pin A1 (ButtonPin) and ground.
+
+ Press the button short (.) or long (-) and wait a second:
+ * ". - ." prints the version.
+ * ". . ." prints the uptime.
+ * "- - -" prints a reset message.
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include "OneButton.h"
+#include "OneButtonGesture.h"
+
+#define PIN_INPUT A1
+
+OneButton button(PIN_INPUT, true);
+OneButtonGesture gesture;
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example with gestures.");
+
+  gesture.addPattern(". - .", []() {
+    Serial.println("Version 1.0");
+  });
+  gesture.addPattern(". . .", []() {
+    Serial.print("Uptime ");
+    Serial.println(millis() / 1000);
+  });
+  gesture.addPattern("- - -", []() {
+    Serial.println("Reset.");
+  });
+  gesture.attachUnknown([]() {
+    Serial.println("unknown sequence.");
+  });
+}  // setup()
+
+
+void loop() {
+  button.tick();
+  gesture.tick(button.debouncedValue());
+  delay(10);
+}  // loop()
+
+// End
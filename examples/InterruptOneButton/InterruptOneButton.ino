@@ -16,13 +16,18 @@
    
  The sketch shows how to setup the library and bind the functions (singleClick, doubleClick) to the events.
  In the loop function the button.tick function must be called as often as you like.
- By using interrupts the internal state advances even when for longer time the button.tick is not called.
+ The interrupt routine only captures the level changes with their time into an edge buffer.
+ tick() in the main loop replays them, so the timing keeps the precision of the interrupt
+ even when for longer time the button.tick is not called.
+ The button state is only changed by tick() in the main loop and the event functions are called
+ from there. So Serial can be used in the event functions.
 */
 
 // 03.03.2011 created by Matthias Hertel
 // 01.12.2011 extension changed to work with the Arduino 1.0 environment
 // 04.11.2017 Interrupt version created.
 // 04.11.2017 Interrupt version using attachInterrupt.
+// 16.10.2026 Edges are captured in the interrupt and replayed by tick() in the main loop.
 
 #include "OneButton.h"
 
@@ -50,7 +55,10 @@
 
 // Setup a new OneButton on pin PIN_INPUT
 // The 2. parameter activeLOW is true, because external wiring sets the button to LOW when pressed.
-OneButton button(PIN_INPUT, true);
+OneButtonFull button(PIN_INPUT, true);
+
+// The buffer for the level changes captured in the interrupt routine.
+OneButtonEdge edgeBuffer[16];
 
 // current LED state, staring with LOW (0)
 int ledState = LOW;
@@ -61,7 +69,7 @@ unsigned long pressStartTime;
 // In case the momentary button puts the input to HIGH when pressed:
 // The 2. parameter activeLOW is false when the external wiring sets the button to HIGH when pressed.
 // The 3. parameter can be used to disable the PullUp .
-// OneButton button(PIN_INPUT, false, false);
+// OneButtonFull button(PIN_INPUT, false, false);
 
 
 // This function is called from the interrupt when the signal on the PIN_INPUT has changed.
@@ -69,19 +77,19 @@ unsigned long pressStartTime;
 #if defined(ARDUINO_AVR_UNO) || defined(ARDUINO_AVR_NANO_EVERY)
 void checkTicks() {
   // include all buttons here to be checked
-  button.tick(); // just call tick() to check the state.
+  button.addEdge(); // just capture the level with its time.
 }
 
 #elif defined(ESP8266)
 ICACHE_RAM_ATTR void checkTicks() {
   // include all buttons here to be checked
-  button.tick(); // just call tick() to check the state.
+  button.addEdge(); // just capture the level with its time.
 }
 
 #elif defined(ESP32)
 void IRAM_ATTR checkTicks() {
   // include all buttons here to be checked
-  button.tick(); // just call tick() to check the state.
+  button.addEdge(); // just capture the level with its time.
 }
 
 #endif
@@ -144,6 +152,9 @@ void setup() {
   pinMode(PIN_LED, OUTPUT); // sets the digital pin as output
   digitalWrite(PIN_LED, ledState);
 
+  // capture the level changes with their time before the interrupt routine is registered.
+  button.setEdgeBuffer(edgeBuffer, 16);
+
   // setup interrupt routine
   // when not registering to the interrupt the sketch also works when the tick is called frequently.
   attachInterrupt(digitalPinToInterrupt(PIN_INPUT), checkTicks, CHANGE);
@@ -171,13 +182,13 @@ void setup() {
 // ISR(PCINT1_vect)
 // {
 //   // keep watching the push button:
-//   button.tick(); // just call tick() to check the state.
+//   button.addEdge(); // just capture the level with its time.
 // }
 
 
 // main code here, to run repeatedly:
 void loop() {
-  // keep watching the push button, even when no interrupt happens:
+  // replay the captured edges and check the timers, this calls the event functions:
   button.tick();
 
   // You can implement other code in here or just wait a while
@@ -0,0 +1,72 @@
+/*
+ ManagedButtons.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to scan several buttons in a separate task
+ by using the OneButtonManager on ESP32.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect pushbuttons to the pins PIN_INPUT1 ... PIN_INPUT3 and ground.
+
+ The buttons are scanned every 5 msecs by a high priority task and the event
+ functions are called by a worker task. The slow long press function does not
+ delay the detection of clicks on the other buttons.
+ The loop function is free for other work and does not need to call tick().
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include "OneButton.h"
+#include "OneButtonManager.h"
+
+#if !defined(ONEBUTTONMANAGER_SUPPORTED)
+#error This example requires ESP32.
+#endif
+
+#define PIN_INPUT1 0
+#define PIN_INPUT2 4
+#define PIN_INPUT3 5
+
+OneButtonFull button1(PIN_INPUT1, true);
+OneButtonFull button2(PIN_INPUT2, true);
+OneButtonFull button3(PIN_INPUT3, true);
+
+// The queue must hold the events detected while an event function is running.
+OneButtonEvent eventBuffer[16];
+OneButtonManager manager(eventBuffer, 16);
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example with a manager task.");
+
+  button1.attachClick([](void *name) {
+    Serial.print((char *)name);
+    Serial.println(" click.");
+  }, (void *)"button1");
+
+  button2.attachClick([](void *name) {
+    Serial.print((char *)name);
+    Serial.println(" click.");
+  }, (void *)"button2");
+
+  // a slow function that does not stop the scanning.
+  button3.attachLongPressStart([]() {
+    Serial.println("button3 long press start, working for 2 seconds...");
+    delay(2000);
+    Serial.println("button3 done.");
+  });
+
+  manager.add(&button1);
+  manager.add(&button2);
+  manager.add(&button3);
+  manager.setScanMs(5);
+  manager.begin();
+}  // setup()
+
+
+void loop() {
+  delay(1000);
+}  // loop()
+
+// End
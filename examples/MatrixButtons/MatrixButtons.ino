@@ -0,0 +1,66 @@
+/*
+ MatrixButtons.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to use the keys of a 4x4 keypad matrix.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect the 4 row lines of the keypad to the pins 2 ... 5.
+ * Connect the 4 column lines of the keypad to the pins 6 ... 9.
+
+ Every key reports clicks, doubleclicks and long presses. Keypads without
+ diodes cannot detect 3 keys at the corners of a rectangle, these
+ combinations are ignored until a key is released.
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include "OneButton.h"
+#include "OneButtonMatrix.h"
+
+const uint8_t rowPins[4] = { 2, 3, 4, 5 };
+const uint8_t colPins[4] = { 6, 7, 8, 9 };
+
+const char keyNames[4][4] = {
+  { '1', '2', '3', 'A' },
+  { '4', '5', '6', 'B' },
+  { '7', '8', '9', 'C' },
+  { '*', '0', '#', 'D' }
+};
+
+OneButton keys[4][4];
+OneButtonMatrix keypad(rowPins, 4, colPins, 4);
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example with a keypad matrix.");
+
+  keypad.begin();
+  for (int r = 0; r < 4; r++) {
+    for (int c = 0; c < 4; c++) {
+      void *name = (void *)&keyNames[r][c];
+      keys[r][c].attachClick([](void *p) {
+        Serial.print(*(char *)p);
+        Serial.println(" click.");
+      }, name);
+      keys[r][c].attachDoubleClick([](void *p) {
+        Serial.print(*(char *)p);
+        Serial.println(" doubleclick.");
+      }, name);
+      keys[r][c].attachLongPressStart([](void *p) {
+        Serial.print(*(char *)p);
+        Serial.println(" long press.");
+      }, name);
+      keypad.attach(r, c, &keys[r][c]);
+    }
+  }
+}  // setup()
+
+
+void loop() {
+  keypad.tick();
+  delay(5);
+}  // loop()
+
+// End
@@ -0,0 +1,65 @@
+/*
+ PinGroupButtons.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to use 4 buttons sharing one interrupt routine.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect 4 pushbuttons to the pins in buttonPins and ground.
+ * The pins must support attachInterrupt, e.g. any GPIO on ESP32 and ESP8266.
+   On the Arduino UNO only the pins 2 and 3 have an interrupt and begin() fails.
+
+ The interrupt routine only marks the buttons with a changed level.
+ The loop function advances the state machines of these buttons and of the
+ buttons with pending timers. The other buttons cost nothing.
+ Without a reader function set by group.setReader() the interrupt routine reads the pins
+ of all 4 buttons on every level change, so its time grows with the number of buttons.
+ For many buttons on one port a reader returning the port register keeps it constant.
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include "OneButton.h"
+#include "OneButtonPinGroup.h"
+
+#if defined(ESP8266)
+const uint8_t buttonPins[4] = { D3, D5, D6, D7 };
+#else
+const uint8_t buttonPins[4] = { 2, 3, 4, 5 };
+#endif
+
+OneButton buttons[4];
+OneButtonPinGroup group;
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example with 4 buttons on one interrupt routine.");
+
+  for (intptr_t n = 0; n < 4; n++) {
+    buttons[n].setup(buttonPins[n], INPUT_PULLUP, true);
+    buttons[n].attachClick([](void *p) {
+      Serial.print("Button ");
+      Serial.print((intptr_t)p);
+      Serial.println(" click.");
+    }, (void *)n);
+    buttons[n].attachLongPressStart([](void *p) {
+      Serial.print("Button ");
+      Serial.print((intptr_t)p);
+      Serial.println(" long press.");
+    }, (void *)n);
+    group.attach(n, &buttons[n]);
+  }
+
+  if (!group.begin()) Serial.println("No free interrupt routine or a pin without interrupt.");
+}  // setup()
+
+
+void loop() {
+  group.tick();
+
+  // other work can be done here.
+  delay(10);
+}  // loop()
+
+// End
@@ -13,6 +13,7 @@
  *
  * * 22.01.2021 created by Matthias Hertel
  * * 07.02.2023 ESP32 Support added.
+ * * 16.10.2026 Lambda capturing the button.
  */
 
 #include "Arduino.h"
@@ -47,8 +48,7 @@ void fClicked(void *s) {
   Serial.println((char *)s);
 }
 
-static void fDoubleClicked(void *oneButton) {
-  OneButton *button = (OneButton *)oneButton;
+static void fDoubleClicked(OneButton *button) {
   Serial.print("pin=");
   Serial.print(button->pin());
   Serial.print(" state=");
@@ -64,9 +64,15 @@ void setup() {
 
   // Here is an example on how to use a parameter to the registered functions:
   button->attachClick(fClicked, (void *)"me");
-  button->attachDoubleClick(fDoubleClicked, &button);
 
-  // Here is an example on how to use an inline function:
+  // Here is an example on how to use a lambda capturing the button:
+  OneButton *b = button;
+  button->attachDoubleClick([b]() {
+    fDoubleClicked(b);
+  });
+
+  // Here is an example on how to use an inline function.
+  // It replaces the function attached to the DoubleClick event before:
   button->attachDoubleClick([]() {
     Serial.println("DoubleClick");
   });
@@ -0,0 +1,87 @@
+/*
+ TraceRecorder.ino - Example for the OneButtonLibrary library.
+ This is a sample sketch to show how to record the raw input levels of a button
+ into a trace for replaying them on a host system.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect a pushbutton to the PIN_INPUT (see defines for processor specific examples) and ground.
+
+ The level passed to button.tick() is recorded as well. When the buffer is full or
+ after 10 seconds the trace is printed as hex dump to Serial and a new trace is started.
+ Copy the hex lines into a file and replay them on the host by using:
+
+   OneButtonReplay -e traces.hex
+*/
+
+// 16.10.2026 created by Matthias Hertel
+
+#include "OneButton.h"
+#include "OneButtonTrace.h"
+
+#if defined(ARDUINO_AVR_UNO) || defined(ARDUINO_AVR_NANO_EVERY)
+#define PIN_INPUT 2
+
+#elif defined(ESP8266)
+#define PIN_INPUT D3
+
+#elif defined(ESP32)
+// Example pin assignments for a ESP32 board
+// Some boards have a BOOT switch using GPIO 0.
+#define PIN_INPUT 0
+
+#endif
+
+#define TRACE_MS 10000
+
+OneButton button;
+
+uint8_t traceBuffer[256];
+OneButtonTraceRecorder recorder(traceBuffer, sizeof(traceBuffer));
+unsigned long traceStart;
+
+
+// print the trace as hex dump in one line.
+void printTrace() {
+  for (uint16_t n = 0; n < recorder.length(); n++) {
+    uint8_t b = recorder.data()[n];
+    if (b < 0x10) Serial.print('0');
+    Serial.print(b, HEX);
+    Serial.print(' ');
+  }
+  Serial.println();
+}  // printTrace()
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("One Button Example recording traces.");
+
+  pinMode(PIN_INPUT, INPUT_PULLUP);
+  button.attachClick([]() {
+    Serial.println("Click");
+  });
+
+  traceStart = millis();
+  recorder.begin(digitalRead(PIN_INPUT) == LOW, traceStart);
+}  // setup()
+
+
+void loop() {
+  bool level = (digitalRead(PIN_INPUT) == LOW);
+  unsigned long now = millis();
+
+  recorder.record(level, now);
+  button.tick(level);
+
+  if (recorder.overflow() || (now - traceStart > TRACE_MS)) {
+    recorder.end(now);
+    printTrace();
+
+    traceStart = now;
+    recorder.begin(level, now);
+  }
+}  // loop()
+
+// End
@@ -52,9 +52,10 @@ Button 2 longPress stop
 #endif
 
 // Setup a new OneButton on pin PIN_INPUT2.
-OneButton button1(PIN_INPUT1, true);
+// OneButtonFull has room for the 5 functions attached to every button.
+OneButtonFull button1(PIN_INPUT1, true);
 // Setup a new OneButton on pin PIN_INPUT2.
-OneButton button2(PIN_INPUT2, true);
+OneButtonFull button2(PIN_INPUT2, true);
 
 
 // setup code here, to run once:
@@ -0,0 +1,104 @@
+// -----
+// MyFsm.h - State machine of the VeryLongPress example extending the transition
+// table of OneButtonFsm by a state for a very long press.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// A long press held down for VERYLONGPRESS_MS goes to the state OCS_VERYLONG and
+// calls veryLongPress(). The release of a very long press reports no LongPressStop event.
+// The timer of OCS_PRESS is used for the very long press so this state machine has
+// no DuringLongPress events.
+// -----
+
+#ifndef MyFsm_h
+#define MyFsm_h
+
+#include "OneButton.h"
+
+#ifndef VERYLONGPRESS_MS
+#define VERYLONGPRESS_MS 3000
+#endif
+
+// This function is implemented by the sketch and called when a very long press is detected.
+void veryLongPress(void *button);
+
+struct MyFsm : OneButtonFsm {
+  enum : uint8_t {
+    OCS_VERYLONG = 8,  // button is hold down for a very long time.
+  };
+
+  enum : uint8_t {
+    TIMER_VERYLONG = TIMER_USER,  // very long press time since the button went down.
+  };
+
+  enum : uint8_t {
+    ACT_VERYLONG = ACT_USER,  // call veryLongPress().
+  };
+
+  static constexpr uint8_t stateCount = 9;
+
+  /**
+   * @return The transition table of OneButtonFsm with the row of OCS_VERYLONG.
+   */
+  static const OneButtonFsmState *states() {
+    enum : uint8_t {
+      INIT = OneButtonBase::OCS_INIT,
+      DOWN = OneButtonBase::OCS_DOWN,
+      COUNT = OneButtonBase::OCS_COUNT,
+      PRESS = OneButtonBase::OCS_PRESS,
+      VERYLONG = OCS_VERYLONG,
+    };
+    static const OneButtonFsmState table[stateCount] ONEBUTTON_PROGMEM = {
+      // timer, transitions when released, pressed, released + timer expired, pressed + timer expired
+      { TIMER_IDLE, { { INIT, ACT_NONE }, { DOWN, ACT_PRESS }, { INIT, ACT_IDLE }, { DOWN, ACT_IDLE_PRESS } } },                  // OCS_INIT
+      { TIMER_PRESS, { { COUNT, ACT_RELEASE }, { DOWN, ACT_NONE }, { COUNT, ACT_RELEASE }, { PRESS, ACT_LONGSTART } } },          // OCS_DOWN
+      { TIMER_NONE, { { COUNT, ACT_RELEASE }, { COUNT, ACT_RELEASE }, { COUNT, ACT_RELEASE }, { COUNT, ACT_RELEASE } } },          // OCS_UP
+      { TIMER_CLICK, { { COUNT, ACT_NONE }, { DOWN, ACT_REPRESS }, { INIT, ACT_CLICKS }, { DOWN, ACT_REPRESS } } },                // OCS_COUNT
+      { TIMER_NONE, { { INIT, ACT_RESTART }, { INIT, ACT_RESTART }, { INIT, ACT_RESTART }, { INIT, ACT_RESTART } } },              // unused
+      { TIMER_NONE, { { INIT, ACT_RESTART }, { INIT, ACT_RESTART }, { INIT, ACT_RESTART }, { INIT, ACT_RESTART } } },              // unused
+      { TIMER_VERYLONG, { { INIT, ACT_LONGSTOP }, { PRESS, ACT_NONE }, { INIT, ACT_LONGSTOP }, { VERYLONG, ACT_VERYLONG } } },     // OCS_PRESS
+      { TIMER_NONE, { { INIT, ACT_LONGSTOP }, { INIT, ACT_LONGSTOP }, { INIT, ACT_LONGSTOP }, { INIT, ACT_LONGSTOP } } },          // OCS_PRESSEND
+      { TIMER_NONE, { { INIT, ACT_RESTART }, { VERYLONG, ACT_NONE }, { INIT, ACT_RESTART }, { VERYLONG, ACT_NONE } } },            // OCS_VERYLONG
+    };
+    return table;
+  };
+
+  /**
+   * @return true when the button is pressed longer than VERYLONGPRESS_MS.
+   */
+  template<class BUTTON>
+  static bool timeout(BUTTON &b, const uint8_t timer) {
+    return (timer == TIMER_VERYLONG) && ((typename BUTTON::time_type)(b.now - b._startTime) > BUTTON::_ticks(VERYLONGPRESS_MS));
+  };
+
+  /**
+   * @brief Get the time when the very long press is detected for tickless scheduling.
+   */
+  template<class BUTTON>
+  static bool deadline(const BUTTON &b, const uint8_t timer, typename BUTTON::time_type &ms) {
+    if (timer != TIMER_VERYLONG) return false;
+    ms = b._startTime + BUTTON::_ticks(VERYLONGPRESS_MS) + 1;
+    return true;
+  };
+
+  /**
+   * Go to the state OCS_VERYLONG and call veryLongPress().
+   */
+  template<class BUTTON>
+  static void action(BUTTON &b, const uint8_t action, const uint8_t next) {
+    if (action == ACT_VERYLONG) {
+      b._newState((OneButtonBase::stateMachine_t)next);
+      veryLongPress(&b);
+    }
+  };
+};
+
+struct MyButtonConfig : OneButtonConfig {
+  typedef MyFsm fsm_type;
+};
+
+typedef OneButtonT<MyButtonConfig> MyButton;
+
+#endif
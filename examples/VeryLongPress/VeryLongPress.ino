@@ -0,0 +1,82 @@
+/*
+ This is a sample sketch to show how to extend the state machine of the OneButtonLibrary
+ by an own state using the transition table in MyFsm.h.
+ The library internals are explained at
+ http://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+
+ Setup a test circuit:
+ * Connect a pushbutton to PIN_INPUT (ButtonPin) and ground.
+
+ A long press that is held down for 3 secs becomes a very long press, e.g. for a factory reset.
+ Its release reports no LongPressStop event.
+ The output of the program is:
+
+OneButton Example.
+Please press and hold the button for more than 3 secs.
+810	 - LongPressStart()
+3010	 - veryLongPress()
+*/
+
+#include "OneButton.h"
+#include "MyFsm.h"
+
+#if defined(ARDUINO_AVR_UNO) || defined(ARDUINO_AVR_NANO_EVERY)
+// Example for Arduino UNO with input button on pin 2
+#define PIN_INPUT 2
+
+#elif defined(ESP8266)
+// Example for NodeMCU with input button using FLASH button on D3
+#define PIN_INPUT D3
+
+#elif defined(ESP32)
+// Example pin assignments for a ESP32 board
+// Some boards have a BOOT switch using GPIO 0.
+#define PIN_INPUT 0
+
+#endif
+
+// Setup a new button using the state machine of MyFsm on pin PIN_INPUT.
+MyButton button(PIN_INPUT, true);
+
+// this function will be called when the button started long pressed.
+void LongPressStart(void *oneButton)
+{
+  Serial.print(((MyButton *)oneButton)->getPressedMs());
+  Serial.println("\t - LongPressStart()");
+}
+
+// this function will be called when the button is released after a long press.
+void LongPressStop(void *oneButton)
+{
+  Serial.print(((MyButton *)oneButton)->getPressedMs());
+  Serial.println("\t - LongPressStop()");
+}
+
+// this function will be called by MyFsm when the button is held down for 3 secs.
+void veryLongPress(void *oneButton)
+{
+  Serial.print(((MyButton *)oneButton)->getPressedMs());
+  Serial.println("\t - veryLongPress()");
+}
+
+// setup code here, to run once:
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println("\nOneButton Example.");
+  Serial.println("Please press and hold the button for more than 3 secs.");
+
+  button.attachLongPressStart(LongPressStart, &button);
+  button.attachLongPressStop(LongPressStop, &button);
+} // setup
+
+
+// main code here, to run repeatedly:
+void loop()
+{
+  // keep watching the push button:
+  button.tick();
+  delay(10);
+} // loop
+
+// End
@@ -0,0 +1,367 @@
+/**
+ * @file OneButtonBench.cpp
+ *
+ * @brief Host benchmark measuring the cost of the OneButton and OneButtonTiny state machines.
+ *
+ * The OneButtonSwitch class runs the former switch based state machine with the features
+ * of OneButtonTiny as a reference. OneButtonTinyTable runs the same transition table as
+ * OneButtonTiny by the table engine used for a fsm_type with its own states.
+ *
+ * The report starts with the RAM used by an instance of every class on the host.
+ *
+ * The buttons are driven by the virtual clock of the host Arduino shim
+ * advancing 1 msec per tick and typical input patterns including bouncing edges.
+ * All timing values are measured in nanoseconds of host cpu time.
+ *
+ * Usage: OneButtonBench [rounds]
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+#include "Arduino.h"
+#include "OneButton.h"
+#include "OneButtonTiny.h"
+#include "OneButtonBank.h"
+#include "OneButtonAnalogSet.h"
+#include "OneButtonMatrix.h"
+#include "OneButtonChord.h"
+#include "OneButtonGesture.h"
+#include "OneButtonEventQueue.h"
+#include "OneButtonManager.h"
+#include "OneButtonPinGroup.h"
+#include "OneButtonInput.h"
+#include "OneButtonTrace.h"
+#include "OneButtonSwitch.h"
+
+#define BENCH_PIN 2
+
+// The table of OneButtonFsm given by another function so the table engine runs it.
+struct BenchTableFsm : OneButtonFsm {
+  static const OneButtonFsmState *states() {
+    return OneButtonFsm::states();
+  };
+};
+
+struct OneButtonTinyTableConfig : OneButtonTinyConfig {
+  typedef BenchTableFsm fsm_type;
+};
+
+typedef OneButtonT<OneButtonTinyTableConfig> OneButtonTinyTable;
+
+// ----- Input patterns -----
+
+// A pattern is a sequence of active levels sampled every msec.
+struct Pattern {
+  const char *name;
+  std::vector<bool> levels;
+};
+
+// append a stable level, optionally starting with some msecs of bouncing.
+static void addLevel(Pattern &p, bool level, int ms, int bounceMs = 0) {
+  for (int n = 0; n < ms; n++) {
+    p.levels.push_back((n < bounceMs) ? ((n % 2) == 0) == level : level);
+  }
+}
+
+static std::vector<Pattern> makePatterns() {
+  std::vector<Pattern> patterns;
+  Pattern p;
+
+  p = Pattern{ "idle", {} };
+  addLevel(p, false, 2000);
+  patterns.push_back(p);
+
+  p = Pattern{ "click", {} };
+  addLevel(p, true, 120);
+  addLevel(p, false, 880);
+  patterns.push_back(p);
+
+  p = Pattern{ "doubleclick", {} };
+  addLevel(p, true, 100);
+  addLevel(p, false, 100);
+  addLevel(p, true, 100);
+  addLevel(p, false, 900);
+  patterns.push_back(p);
+
+  p = Pattern{ "longpress", {} };
+  addLevel(p, true, 2000);
+  addLevel(p, false, 1000);
+  patterns.push_back(p);
+
+  p = Pattern{ "bouncy", {} };
+  addLevel(p, true, 150, 12);
+  addLevel(p, false, 850, 12);
+  patterns.push_back(p);
+
+  return patterns;
+}
+
+
+// ----- Event counting -----
+
+static unsigned long eventCount = 0;
+
+static void countEvent() {
+  eventCount++;
+}
+
+static volatile int sink;  // prevent optimizing the debounce calls away.
+
+
+// ----- Measurement -----
+
+typedef std::chrono::steady_clock benchClock;
+
+static double nsSince(benchClock::time_point start) {
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(benchClock::now() - start).count();
+}
+
+template<class BUTTON>
+static void benchButton(const char *className, const Pattern &p, int rounds) {
+  const size_t len = p.levels.size();
+  const double ticks = (double)len * rounds;
+  unsigned long transitions = 0;
+  unsigned long events;
+  double nsTick, nsPinTick, nsDebounce;
+
+  // tick(bool) using a given level
+  {
+    ArduinoHost::reset();
+    BUTTON b(BENCH_PIN);
+    b.attachClick(countEvent);
+    b.attachDoubleClick(countEvent);
+    b.attachLongPressStart(countEvent);
+    eventCount = 0;
+
+    benchClock::time_point start = benchClock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (size_t n = 0; n < len; n++) {
+        ArduinoHost::advanceMillis(1);
+        b.tick(p.levels[n]);
+      }
+    }
+    nsTick = nsSince(start);
+    events = eventCount;
+  }
+
+  // tick() reading the pin by using digitalRead()
+  {
+    ArduinoHost::reset();
+    BUTTON b(BENCH_PIN);
+    b.attachClick(countEvent);
+    b.attachDoubleClick(countEvent);
+    b.attachLongPressStart(countEvent);
+
+    benchClock::time_point start = benchClock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (size_t n = 0; n < len; n++) {
+        ArduinoHost::advanceMillis(1);
+        ArduinoHost::setPinLevel(BENCH_PIN, p.levels[n] ? LOW : HIGH);
+        b.tick();
+      }
+    }
+    nsPinTick = nsSince(start);
+  }
+
+  // debounce() only
+  {
+    ArduinoHost::reset();
+    BUTTON b(BENCH_PIN);
+    int level = 0;
+
+    benchClock::time_point start = benchClock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (size_t n = 0; n < len; n++) {
+        ArduinoHost::advanceMillis(1);
+        level += b.debounce(p.levels[n]);
+      }
+    }
+    nsDebounce = nsSince(start);
+    sink = level;
+  }
+
+  // count the state transitions in a separate, not measured run
+  {
+    ArduinoHost::reset();
+    BUTTON b(BENCH_PIN);
+    b.attachClick(countEvent);
+    b.attachDoubleClick(countEvent);
+    b.attachLongPressStart(countEvent);
+
+    for (int r = 0; r < rounds; r++) {
+      for (size_t n = 0; n < len; n++) {
+        auto oldState = b.state();
+        ArduinoHost::advanceMillis(1);
+        b.tick(p.levels[n]);
+        if (b.state() != oldState) transitions++;
+      }
+    }
+  }
+
+  printf("%-18s %-12s %10.2f %10.2f %10.2f %12lu %12.1f %10lu\n",
+         className, p.name,
+         nsTick / ticks, nsPinTick / ticks, nsDebounce / ticks,
+         transitions, transitions ? nsTick / transitions : 0.0,
+         events);
+}  // benchButton()
+
+
+// ----- Scanning many buttons -----
+
+#define SCAN_BUTTONS 32
+
+// Input words for a panel of buttons where only every 8th button is used
+// with an offset into the pattern and all other buttons stay released.
+static std::vector<uint32_t> makeScanWords(const Pattern &p) {
+  const size_t len = p.levels.size();
+  std::vector<uint32_t> words(len, 0);
+
+  for (size_t n = 0; n < len; n++) {
+    for (int lane = 0; lane < SCAN_BUTTONS; lane += 8) {
+      if (p.levels[(n + lane * 97) % len]) words[n] |= ((uint32_t)1 << lane);
+    }
+  }
+  return words;
+}
+
+static void attachEvents(OneButton *buttons) {
+  for (int n = 0; n < SCAN_BUTTONS; n++) {
+    buttons[n].attachClick(countEvent);
+    buttons[n].attachDoubleClick(countEvent);
+    buttons[n].attachLongPressStart(countEvent);
+  }
+}
+
+static void benchScan(const Pattern &p, int rounds) {
+  std::vector<uint32_t> words = makeScanWords(p);
+  const size_t len = words.size();
+  const double scans = (double)len * rounds;
+  unsigned long events;
+  double nsSingle, nsAll, nsBank;
+
+  // tick(bool) on every single button
+  {
+    ArduinoHost::reset();
+    OneButton buttons[SCAN_BUTTONS];
+    attachEvents(buttons);
+    eventCount = 0;
+
+    benchClock::time_point start = benchClock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (size_t n = 0; n < len; n++) {
+        ArduinoHost::advanceMillis(1);
+        uint32_t w = words[n];
+        for (int lane = 0; lane < SCAN_BUTTONS; lane++) {
+          buttons[lane].tick((w >> lane) & 1);
+        }
+      }
+    }
+    nsSingle = nsSince(start);
+    events = eventCount;
+  }
+  printf("%-14s %-12s %10.2f %10lu\n", "OneButton", p.name, nsSingle / scans, events);
+
+  // OneButton::tickAll() with one time for all buttons
+  {
+    ArduinoHost::reset();
+    OneButton buttons[SCAN_BUTTONS];
+    attachEvents(buttons);
+    eventCount = 0;
+
+    benchClock::time_point start = benchClock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (size_t n = 0; n < len; n++) {
+        ArduinoHost::advanceMillis(1);
+        OneButton::tickAll(buttons, SCAN_BUTTONS, &words[n]);
+      }
+    }
+    nsAll = nsSince(start);
+    events = eventCount;
+  }
+  printf("%-14s %-12s %10.2f %10lu\n", "tickAll", p.name, nsAll / scans, events);
+
+  // OneButtonBank
+  {
+    ArduinoHost::reset();
+    OneButton buttons[SCAN_BUTTONS];
+    OneButtonBank bank;
+    attachEvents(buttons);
+    for (int lane = 0; lane < SCAN_BUTTONS; lane++) bank.attach(lane, &buttons[lane]);
+    eventCount = 0;
+
+    benchClock::time_point start = benchClock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (size_t n = 0; n < len; n++) {
+        ArduinoHost::advanceMillis(1);
+        bank.tick(words[n]);
+      }
+    }
+    nsBank = nsSince(start);
+    events = eventCount;
+  }
+  printf("%-14s %-12s %10.2f %10lu\n", "OneButtonBank", p.name, nsBank / scans, events);
+}  // benchScan()
+
+
+// ----- Instance sizes -----
+
+#define PRINT_SIZE(type) printf("%-22s %6u\n", #type, (unsigned)sizeof(type))
+
+static void printSizes() {
+  printf("%-22s %6s\n", "class", "bytes");
+  PRINT_SIZE(OneButton);
+  PRINT_SIZE(OneButtonFull);
+  PRINT_SIZE(OneButtonTiny);
+  PRINT_SIZE(OneButtonSwitch);
+  PRINT_SIZE(OneButtonEvent);
+  PRINT_SIZE(OneButtonBank);
+  PRINT_SIZE(OneButtonAnalogSet);
+  PRINT_SIZE(OneButtonMatrix);
+  PRINT_SIZE(OneButtonChord);
+  PRINT_SIZE(OneButtonGesture);
+  PRINT_SIZE(OneButtonEventQueue);
+  PRINT_SIZE(OneButtonManager);
+  PRINT_SIZE(OneButtonPinGroup);
+  PRINT_SIZE(OneButtonInputGroup);
+  PRINT_SIZE(OneButtonTraceRecorder);
+}  // printSizes()
+
+
+int main(int argc, char *argv[]) {
+  int rounds = (argc > 1) ? atoi(argv[1]) : 200;
+  if (rounds <= 0) rounds = 1;
+
+  std::vector<Pattern> patterns = makePatterns();
+
+  printf("OneButton host benchmark, %d rounds per pattern, 1 msec per tick.\n\n", rounds);
+  printSizes();
+
+  printf("\n%-18s %-12s %10s %10s %10s %12s %12s %10s\n",
+         "class", "pattern", "ns/tick(b)", "ns/tick()", "ns/deb", "transitions", "ns/trans", "events");
+
+  for (const Pattern &p : patterns) {
+    benchButton<OneButton>("OneButton", p, rounds);
+    benchButton<OneButtonTiny>("OneButtonTiny", p, rounds);
+    benchButton<OneButtonTinyTable>("OneButtonTinyTable", p, rounds);
+    benchButton<OneButtonSwitch>("OneButtonSwitch", p, rounds);
+  }
+
+  printf("\nScanning %d buttons, 1 scan per msec.\n\n", SCAN_BUTTONS);
+  printf("%-14s %-12s %10s %10s\n", "class", "pattern", "ns/scan", "events");
+
+  for (const Pattern &p : patterns) {
+    benchScan(p, rounds);
+  }
+  return 0;
+}  // main()
+
+
+// end.
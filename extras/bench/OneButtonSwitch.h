@@ -0,0 +1,132 @@
+// -----
+// OneButtonSwitch.h - The former switch based state machine of OneButtonTiny
+// kept as a reference for the host benchmark only.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// This class has the events, timing and debouncing of OneButtonTiny and
+// runs the FSM with the switch statement that was used before the transition
+// table. The states UP and PRESSEND are passed with an extra tick.
+// -----
+
+#ifndef OneButtonSwitch_h
+#define OneButtonSwitch_h
+
+#include "Arduino.h"
+#include "OneButtonT.h"
+
+class OneButtonSwitch : public OneButtonBase {
+public:
+  typedef uint16_t time_type;
+
+  explicit OneButtonSwitch(const int pin) {
+    _pin = pin;
+    _buttonPressed = LOW;
+    pinMode(pin, INPUT_PULLUP);
+  };
+
+  void attachClick(callbackFunction newFunction) {
+    _clickFunc = newFunction;
+  };
+  void attachDoubleClick(callbackFunction newFunction) {
+    _doubleClickFunc = newFunction;
+    _maxClicks = 2;
+  };
+  void attachLongPressStart(callbackFunction newFunction) {
+    _longPressStartFunc = newFunction;
+  };
+
+  void tick(void) {
+    tick(isPinActive());
+  };
+
+  void tick(bool activeLevel) {
+    now = (time_type)millis();
+    _fsm(_debouncer.debounce(activeLevel, now, _debounce_ms));
+  };
+
+  bool debounce(const bool value) {
+    now = (time_type)millis();
+    return _debouncer.debounce(value, now, _debounce_ms);
+  };
+
+private:
+  int _debounce_ms = 50;
+  unsigned int _click_ms = 400;
+  unsigned int _press_ms = 800;
+
+  callbackFunction _clickFunc = NULL;
+  callbackFunction _doubleClickFunc = NULL;
+  callbackFunction _longPressStartFunc = NULL;
+
+  OneButtonDebounceTime<time_type> _debouncer;
+  time_type now = 0;
+  time_type _startTime = 0;
+
+  void _reset(void) {
+    _state = OCS_INIT;
+    _nClicks = 0;
+    _startTime = (time_type)millis();
+  };
+
+  void _fsm(bool activeLevel) {
+    time_type waitTime = (time_type)(now - _startTime);
+
+    switch (_state) {
+      case OCS_INIT:
+        if (activeLevel) {
+          _state = OCS_DOWN;
+          _startTime = now;
+          _nClicks = 0;
+        }
+        break;
+
+      case OCS_DOWN:
+        if (!activeLevel) {
+          _state = OCS_UP;
+          _startTime = now;
+
+        } else if (waitTime > _press_ms) {
+          if (_longPressStartFunc) _longPressStartFunc();
+          _state = OCS_PRESS;
+        }
+        break;
+
+      case OCS_UP:
+        _nClicks++;
+        _state = OCS_COUNT;
+        break;
+
+      case OCS_COUNT:
+        if (activeLevel) {
+          _state = OCS_DOWN;
+          _startTime = now;
+
+        } else if ((waitTime >= _click_ms) || (_nClicks == _maxClicks)) {
+          if (_nClicks == 1) {
+            if (_clickFunc) _clickFunc();
+          } else if (_nClicks == 2) {
+            if (_doubleClickFunc) _doubleClickFunc();
+          }
+          _reset();
+        }
+        break;
+
+      case OCS_PRESS:
+        if (!activeLevel) _state = OCS_PRESSEND;
+        break;
+
+      case OCS_PRESSEND:
+        _reset();
+        break;
+
+      default:
+        _state = OCS_INIT;
+        break;
+    }  // switch
+  };
+};
+
+#endif
@@ -0,0 +1,1161 @@
+/**
+ * @file OneButtonCheck.cpp
+ *
+ * @brief Host checks of the OneButton state machine registered as CTest tests.
+ *
+ * edges: A random input with bouncing contacts is given to one button by polling every msec
+ * and to another button by edges captured with their time and replayed by ticks at random
+ * intervals. Both buttons must report the same events with the same values and times.
+ *
+ * glitch: A short glitch that settles back to the debounced level must not be learned as a
+ * bounce burst by the adaptive debouncing.
+ *
+ * detach: Passing NULL, 0 or nullptr to the attach functions compiles and removes the functions.
+ *
+ * trace: Recorded levels with large time differences are read back unchanged, a time going
+ * backwards is not recorded.
+ *
+ * table: The transition table of OneButtonFsm run by the table engine reports the same events
+ * as the switch compiled from it for a random input.
+ *
+ * userfsm: The state OCS_VERYLONG added by MyFsm of the VeryLongPress example is entered after
+ * 3 secs by its timer and action and has a deadline for tickless scheduling.
+ *
+ * bank: The vertical counters of OneButtonBank debounce random words like a counter per lane
+ * for all numbers of samples and a click on an active LOW lane is reported by its button only.
+ *
+ * queue: Events dispatched from an OneButtonEventQueue at random intervals are the same as the
+ * events of a button calling the functions directly, a full queue drops and counts new events.
+ *
+ * deadline: A button ticked only at the level changes and at the time of nextDeadlineMs() reports
+ * the same events as a button polled every msec.
+ *
+ * stats: The counters of a button with stats enabled count the ticks, the longest gap between
+ * them, the rejected bounces, the events and the time spent in the attached functions.
+ *
+ * tentative: The first click is reported at its release, a single click confirms it after the
+ * click time and a second press supersedes it before the double click is reported.
+ *
+ * analogset: The samples of a resistor ladder are decoded with hysteresis, a voltage passing other
+ * entries is not taken over and a click read from the analog pin is reported by its button only.
+ *
+ * chord: 2 buttons pressed within the chord time report the chord and no clicks, a single button
+ * and buttons pressed too far apart report their clicks and no chord.
+ *
+ * gesture: Sequences of short and long presses call the function of their pattern, sequences that
+ * end inside or outside of the trie call the unknown function, a sequence ends after the pause.
+ *
+ * clocks: A button using OneButtonClockMicros takes over a press of 2 msecs after a debounce time of
+ * 300 usecs and rejects a shorter glitch, a button using OneButtonClockMillis64 reports a long press
+ * across the wrap of the 32-bit millis() with its full duration.
+ *
+ * tickall: 40 buttons advanced by tickAll() with packed levels report the same events as 40 buttons
+ * ticked one by one.
+ *
+ * autorepeat: The auto repeat starts after its delay and its interval shrinks to the shortest
+ * interval, late ticks report the repeats due meanwhile by one event with the same total count.
+ *
+ * inputgroup: 16 active LOW buttons of an OneButtonInputGroup read by one transaction per tick report
+ * the same events as 16 buttons polled every msec, a busy source keeps the levels of the last read.
+ *
+ * Usage: OneButtonCheck [check] [rounds]
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ */
+
+#include <random>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "OneButton.h"
+#include "OneButtonAnalogSet.h"
+#include "OneButtonBank.h"
+#include "OneButtonChord.h"
+#include "OneButtonEventQueue.h"
+#include "OneButtonGesture.h"
+#include "OneButtonInput.h"
+#include "OneButtonTrace.h"
+#include "MyFsm.h"
+
+typedef std::vector<std::string> EventLog;
+
+static const char *eventNames[] = {
+  "press", "click", "double", "multi", "start", "during", "stop", "idle", "tentative", "super"
+};
+
+// log the events of the button given as parameter.
+static EventLog *logOf[2];
+static OneButtonBase *buttonOf[2];
+
+static void logEvent(const OneButtonEvent &e) {
+  char line[100];
+  snprintf(line, sizeof(line), "%6lu %-9s clicks=%u gaps=%u,%u,%u dur=%lu",
+           e.time, eventNames[e.event], e.clicks, e.gaps[0], e.gaps[1], e.gaps[2], e.duration);
+  for (int n = 0; n < 2; n++) {
+    if (e.button == buttonOf[n]) logOf[n]->push_back(line);
+  }
+}
+
+template<class BUTTON>
+static void setupButton(BUTTON &b) {
+  b.setDebounceMs(20);
+  b.setClickMs(400);
+  b.setPressMs(800);
+  b.setLongPressIntervalMs(100);
+  b.attachPress(logEvent);
+  b.attachClick(logEvent);
+  b.attachDoubleClick(logEvent);
+  b.attachMultiClick(logEvent);
+  b.attachLongPressStart(logEvent);
+  b.attachLongPressStop(logEvent);
+  b.attachDuringLongPress(logEvent);
+  b.attachIdle(logEvent);
+}
+
+// random levels with bouncing edges, each level held up to 1.2 secs.
+static std::vector<bool> randomLevels(std::mt19937 &rnd) {
+  std::vector<bool> levels;
+  bool level = false;
+  while (levels.size() < 30000) {
+    level = !level;
+    for (int b = rnd() % 3; b > 0; b--) {
+      levels.push_back(level);
+      levels.push_back(!level);
+    }
+    for (int n = 1 + rnd() % 1200; n > 0; n--) levels.push_back(level);
+  }
+  for (int n = 0; n < 3000; n++) levels.push_back(false);
+  return levels;
+}
+
+// print the first difference of the logs.
+static bool compareLogs(const char *name, const EventLog &expected, const EventLog &found) {
+  size_t n = 0;
+  while ((n < expected.size()) && (n < found.size()) && (expected[n] == found[n])) n++;
+  if ((n == expected.size()) && (n == found.size())) return true;
+
+  printf("%s: event %u differs\n", name, (unsigned)n);
+  printf("  expected: %s\n", (n < expected.size()) ? expected[n].c_str() : "(none)");
+  printf("  found:    %s\n", (n < found.size()) ? found[n].c_str() : "(none)");
+  return false;
+}
+
+
+// ----- Edge replay compared to polling -----
+
+static bool checkEdges(int rounds) {
+  std::mt19937 rnd(4711);
+  bool ok = true;
+
+  for (int r = 0; r < rounds; r++) {
+    OneButtonFull polled, replayed;
+    OneButtonEdge buffer[64];
+    EventLog polledLog, replayedLog;
+
+    ArduinoHost::reset();
+    buttonOf[0] = &polled;
+    buttonOf[1] = &replayed;
+    logOf[0] = &polledLog;
+    logOf[1] = &replayedLog;
+    setupButton(polled);
+    setupButton(replayed);
+    replayed.setEdgeBuffer(buffer, 64);
+
+    std::vector<bool> levels = randomLevels(rnd);
+
+    unsigned long nextTick = 0;
+    bool last = false;
+    for (unsigned long ms = 1; ms <= levels.size(); ms++) {
+      bool l = levels[ms - 1];
+      polled.tickAt(l, ms);
+      if (l != last) replayed.addEdge(l, ms);
+      last = l;
+      if (ms >= nextTick) {
+        replayed.tickAt(ms);
+        nextTick = ms + 1 + rnd() % 300;
+      }
+    }
+    replayed.tickAt(levels.size());
+
+    char name[32];
+    snprintf(name, sizeof(name), "edges round %d", r);
+    if (!compareLogs(name, polledLog, replayedLog)) {
+      ok = false;
+      break;
+    }
+  }
+  return ok;
+}  // checkEdges()
+
+
+// ----- Adaptive debouncing with glitches -----
+
+// press and release the button with a bounce burst of the given msecs on both edges.
+static unsigned long bouncePress(OneButton &b, unsigned long ms, int bounceMs) {
+  for (int n = 0; n < 2; n++) {
+    bool level = (n == 0);
+    for (int t = 0; t < bounceMs; t++) b.tickAt((t % 2 == 0) ? level : !level, ms++);
+    for (int t = 0; t < 300; t++) b.tickAt(level, ms++);
+  }
+  return ms;
+}
+
+static bool checkGlitch() {
+  OneButton b;
+  bool ok = true;
+  unsigned long ms = 1;
+
+  ArduinoHost::reset();
+  b.setAdaptiveDebounce(2, 50);
+  for (int n = 0; n < 30; n++) ms = bouncePress(b, ms, 3);
+  unsigned int learned = b.getBounceMs();
+  unsigned int window = b.getDebounceMs();
+
+  // a 1 msec glitch long before the next press.
+  b.tickAt(true, ms++);
+  for (int t = 0; t < 2000; t++) b.tickAt(false, ms++);
+  ms = bouncePress(b, ms, 3);
+
+  if ((b.getBounceMs() > learned) || (b.getDebounceMs() > window)) ok = false;
+  printf("glitch: learned %u msecs, window %u msecs, after the glitch %u msecs, window %u msecs\n",
+         learned, window, b.getBounceMs(), b.getDebounceMs());
+  return ok;
+}  // checkGlitch()
+
+
+// ----- Removing functions by NULL, 0 and nullptr -----
+
+static int detachCalls = 0;
+
+static void countCall() {
+  detachCalls++;
+}
+
+// click the button and return the number of calls.
+static int clickCalls(OneButton &b) {
+  detachCalls = 0;
+  b.reset();
+  for (unsigned long ms = 1; ms < 2000; ms++) b.tickAt((ms >= 100) && (ms < 200), ms);
+  return detachCalls;
+}
+
+static bool checkDetach() {
+  OneButton b;
+  bool ok = true;
+
+  ArduinoHost::reset();
+  b.attachClick(countCall);
+  b.attachPress(countCall);
+  b.attachIdle(countCall);
+  if (clickCalls(b) != 3) ok = false;
+
+  b.attachClick(NULL);
+  b.attachPress(0);
+  b.attachIdle(nullptr);
+  if (clickCalls(b) != 0) ok = false;
+  return ok;
+}  // checkDetach()
+
+
+// ----- Trace with large and backward time differences -----
+
+static bool checkTrace() {
+  uint8_t buffer[100];
+  OneButtonTraceRecorder rec(buffer, sizeof(buffer));
+  const unsigned long start = 1000;
+  const unsigned long later = start + (ULONG_MAX >> 2);  // beyond 2^35 with 64 bit.
+  const unsigned long times[] = { start + 5, start + 70000, later, later + 7 };
+  bool ok = true;
+
+  rec.begin(false, start);
+  bool level = false;
+  for (unsigned long t : times) {
+    level = !level;
+    if (!rec.record(level, t)) ok = false;
+  }
+  if (rec.record(!level, start)) ok = false;  // backwards.
+  rec.end(later + 10);
+  if (rec.overflow()) ok = false;
+
+  OneButtonTraceReader reader(rec.data(), rec.length());
+  bool l;
+  unsigned long ms;
+  if (!reader.next(l, ms) || l || (ms != 0)) ok = false;  // times relative to the start.
+  level = false;
+  for (unsigned long t : times) {
+    level = !level;
+    if (!reader.next(l, ms) || (l != level) || (ms != t - start)) ok = false;
+  }
+  if (!reader.next(l, ms) || (l != level) || reader.next(l, ms)) ok = false;  // end mark.
+
+  // a record longer than the width of unsigned long is read without shifting beyond it.
+  uint8_t longRecord[ONEBUTTONTRACE_HEADER + 16] = { 'O', 'B', ONEBUTTONTRACE_VERSION, 0, 16, 0 };
+  for (int n = 0; n < 15; n++) longRecord[ONEBUTTONTRACE_HEADER + n] = 0xFF;
+  longRecord[ONEBUTTONTRACE_HEADER + 15] = 0x01;
+  OneButtonTraceReader longReader(longRecord, sizeof(longRecord));
+  if (!longReader.next(l, ms) || !l || longReader.next(l, ms)) ok = false;
+  return ok;
+}  // checkTrace()
+
+
+// ----- Transition table compared to the switch -----
+
+// runs the table of OneButtonFsm by the table engine as states() is another function.
+struct TableFsm : OneButtonFsm {
+  static const OneButtonFsmState *states() {
+    return OneButtonFsm::states();
+  };
+};
+
+struct TableConfig : OneButtonFullConfig {
+  typedef TableFsm fsm_type;
+};
+
+static bool checkTable(int rounds) {
+  std::mt19937 rnd(815);
+  bool ok = true;
+
+  for (int r = 0; (r < rounds) && ok; r++) {
+    OneButtonFull switched;
+    OneButtonT<TableConfig> table;
+    EventLog switchedLog, tableLog;
+
+    ArduinoHost::reset();
+    buttonOf[0] = &switched;
+    buttonOf[1] = &table;
+    logOf[0] = &switchedLog;
+    logOf[1] = &tableLog;
+    setupButton(switched);
+    setupButton(table);
+    switched.attachTentativeClick(logEvent);
+    table.attachTentativeClick(logEvent);
+    switched.attachClickSuperseded(logEvent);
+    table.attachClickSuperseded(logEvent);
+
+    std::vector<bool> levels = randomLevels(rnd);
+    for (unsigned long ms = 1; ms <= levels.size(); ms++) {
+      switched.tickAt(levels[ms - 1], ms);
+      table.tickAt(levels[ms - 1], ms);
+      if (switched.state() != table.state()) ok = false;
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "table round %d", r);
+    if (!compareLogs(name, switchedLog, tableLog)) ok = false;
+  }
+  return ok;
+}  // checkTable()
+
+
+// ----- User state of the VeryLongPress example -----
+
+static unsigned long veryLongMs = 0;
+static int stopCalls = 0;
+
+void veryLongPress(void *button) {
+  veryLongMs = ((MyButton *)button)->getPressedMs();
+}
+
+static void countStop() {
+  stopCalls++;
+}
+
+// tick the button every msec of the host clock with the level for the given msecs.
+static void hold(MyButton &b, bool level, unsigned long holdMs) {
+  for (unsigned long t = 0; t < holdMs; t++) {
+    ArduinoHost::advanceMillis(1);
+    b.tick(level);
+  }
+}
+
+static bool checkUserFsm() {
+  MyButton b;
+  bool ok = true;
+
+  ArduinoHost::reset();
+  b.attachLongPressStop(countStop);
+
+  // a long press stays a long press.
+  hold(b, true, 2000);
+  hold(b, false, 1000);
+  if ((veryLongMs != 0) || (stopCalls != 1)) ok = false;
+
+  // a very long press after 3 secs without LongPressStop.
+  unsigned long start = millis() + 1 + b.getDebounceMs();  // the press is taken over after debouncing.
+  hold(b, true, 1000);
+  MyButton::time_type deadline;
+  if ((b.state() != OneButtonBase::OCS_PRESS) || !b.nextDeadlineMs(deadline) || (deadline != start + VERYLONGPRESS_MS + 1)) ok = false;
+  hold(b, true, 3000);
+  hold(b, false, 1000);
+  if ((veryLongMs != VERYLONGPRESS_MS + 1) || (stopCalls != 1) || (b.state() != OneButtonBase::OCS_INIT)) ok = false;
+
+  printf("userfsm: very long press after %lu msecs, %d LongPressStop events\n", veryLongMs, stopCalls);
+  return ok;
+}  // checkUserFsm()
+
+
+// ----- Vertical counters of the bank -----
+
+static int bankClicks[ONEBUTTONBANK_LANES];
+
+static void countBankClick(void *lane) {
+  bankClicks[(intptr_t)lane]++;
+}
+
+static bool checkBank(int rounds) {
+  std::mt19937 rnd(1234);
+  bool ok = true;
+
+  // the debounced levels of random words with a counter per lane.
+  for (uint8_t samples = 1; samples <= 8; samples++) {
+    OneButtonBank bank;
+    uint8_t counter[ONEBUTTONBANK_LANES] = {};
+    uint32_t levels = 0;
+
+    ArduinoHost::reset();
+    bank.setSampleMs(1);
+    bank.setDebounceSamples(samples);
+    for (int n = 0; n < rounds * 1000; n++) {
+      uint32_t inputs = (n % 64 < 32) ? rnd() : (uint32_t)((rnd() & 0x0F) ? levels : ~levels);
+      ArduinoHost::advanceMillis(1);
+      bank.tick(inputs);
+
+      for (int lane = 0; lane < ONEBUTTONBANK_LANES; lane++) {
+        uint32_t bit = (uint32_t)1 << lane;
+        if (!((inputs ^ levels) & bit)) {
+          counter[lane] = 0;
+        } else if (++counter[lane] == samples) {
+          counter[lane] = 0;
+          levels ^= bit;
+        }
+      }
+      if (bank.debouncedLevels() != levels) {
+        printf("bank: %u samples, word %d: debounced %08lx, expected %08lx\n", samples, n,
+               (unsigned long)bank.debouncedLevels(), (unsigned long)levels);
+        ok = false;
+        break;
+      }
+    }
+  }
+
+  // a click on the active LOW lane 5 only.
+  OneButton buttons[ONEBUTTONBANK_LANES];
+  OneButtonBank bank;
+
+  ArduinoHost::reset();
+  bank.setActiveLowMask(0xFFFFFFFF);
+  for (int lane = 0; lane < ONEBUTTONBANK_LANES; lane++) {
+    bankClicks[lane] = 0;
+    buttons[lane].attachClick(countBankClick, (void *)(intptr_t)lane);
+    bank.attach(lane, &buttons[lane]);
+  }
+  for (int ms = 0; ms < 2000; ms++) {
+    ArduinoHost::advanceMillis(1);
+    bank.tick(((ms >= 100) && (ms < 250)) ? ~((uint32_t)1 << 5) : 0xFFFFFFFF);
+  }
+  for (int lane = 0; lane < ONEBUTTONBANK_LANES; lane++) {
+    if (bankClicks[lane] != ((lane == 5) ? 1 : 0)) ok = false;
+  }
+  if (bank.pendingLanes() != 0) ok = false;
+  return ok;
+}  // checkBank()
+
+
+// ----- Event queue compared to direct calls -----
+
+static bool checkQueue(int rounds) {
+  std::mt19937 rnd(2024);
+  bool ok = true;
+
+  for (int r = 0; (r < rounds) && ok; r++) {
+    OneButtonFull direct, queued;
+    OneButtonEvent buffer[16];
+    OneButtonEventQueue queue(buffer, 16);
+    EventLog directLog, queuedLog;
+
+    ArduinoHost::reset();
+    buttonOf[0] = &direct;
+    buttonOf[1] = &queued;
+    logOf[0] = &directLog;
+    logOf[1] = &queuedLog;
+    setupButton(direct);
+    setupButton(queued);
+    queued.setEventQueue(&queue);
+
+    std::vector<bool> levels = randomLevels(rnd);
+    unsigned long nextDispatch = 0;
+    for (unsigned long ms = 1; ms <= levels.size(); ms++) {
+      direct.tickAt(levels[ms - 1], ms);
+      queued.tickAt(levels[ms - 1], ms);
+      if (ms >= nextDispatch) {
+        queue.dispatch();
+        nextDispatch = ms + 1 + rnd() % 100;
+      }
+    }
+    queue.dispatch();
+
+    char name[32];
+    snprintf(name, sizeof(name), "queue round %d", r);
+    if (directLog.empty() || !compareLogs(name, directLog, queuedLog) || (queue.dropped() != 0)) ok = false;
+  }
+
+  // a buffer of 10 events is used for 8 events.
+  OneButtonEvent buffer[10];
+  OneButtonEventQueue queue(buffer, 10);
+  OneButtonEvent e = {};
+  for (uint8_t n = 0; n < 10; n++) {
+    e.clicks = n;
+    if (queue.push(e) != (n < 8)) ok = false;
+  }
+  if ((queue.count() != 8) || (queue.dropped() != 2)) ok = false;
+  for (uint8_t n = 0; n < 8; n++) {
+    if (!queue.pop(e) || (e.clicks != n)) ok = false;
+  }
+  if (queue.pop(e) || (queue.count() != 0)) ok = false;
+  return ok;
+}  // checkQueue()
+
+
+// ----- Tickless scheduling by deadlines compared to polling -----
+
+static bool checkDeadline(int rounds) {
+  std::mt19937 rnd(5005);
+  bool ok = true;
+
+  for (int r = 0; (r < rounds) && ok; r++) {
+    OneButtonFull polled, tickless;
+    EventLog polledLog, ticklessLog;
+    unsigned long ticks = 0;
+
+    ArduinoHost::reset();
+    buttonOf[0] = &polled;
+    buttonOf[1] = &tickless;
+    logOf[0] = &polledLog;
+    logOf[1] = &ticklessLog;
+    setupButton(polled);
+    setupButton(tickless);
+
+    std::vector<bool> levels = randomLevels(rnd);
+    bool last = false;
+    OneButtonFull::time_type deadline = 0;
+    bool pending = false;
+    for (unsigned long ms = 1; ms <= levels.size(); ms++) {
+      bool l = levels[ms - 1];
+      polled.tickAt(l, ms);
+      if ((l != last) || (pending && ((long)(ms - deadline) >= 0))) {
+        tickless.tickAt(l, ms);
+        pending = tickless.nextDeadlineMs(deadline);
+        ticks++;
+      }
+      last = l;
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "deadline round %d", r);
+    if (polledLog.empty() || !compareLogs(name, polledLog, ticklessLog) || (ticks * 4 > levels.size())) ok = false;
+  }
+  return ok;
+}  // checkDeadline()
+
+
+// ----- Counters of the stats -----
+
+struct StatsConfig : OneButtonConfig {
+  static constexpr bool stats = true;
+};
+
+typedef OneButtonT<StatsConfig> StatsButton;
+
+// an attached function running for 250 usecs.
+static void slowCall() {
+  ArduinoHost::advanceMicros(250);
+}
+
+static bool checkStats() {
+  StatsButton b;
+  bool ok = true;
+  unsigned long ms = 1;
+
+  ArduinoHost::reset();
+  b.attachClick(slowCall);
+  b.attachLongPressStart(slowCall);
+
+  // a clean click, a gap of 37 msecs between 2 ticks and a long press with a bouncing release.
+  for (int t = 0; t < 200; t++) b.tickAt(t < 150, ms++);
+  ms += 36;
+  for (int t = 0; t < 1000; t++) b.tickAt(false, ms++);
+  if (b.stats().bounces != 0) ok = false;
+  for (int t = 0; t < 1000; t++) b.tickAt(t < 900, ms++);
+  for (int t = 0; t < 6; t++) b.tickAt(t % 2 == 0, ms++);
+  for (int t = 0; t < 1000; t++) b.tickAt(false, ms++);
+
+  const OneButtonStats &s = b.stats();
+  if ((s.ticks != 3206) || (s.maxTickGapMs != 37) || (s.bounces == 0)) ok = false;
+  if ((s.events[OneButtonBase::EV_CLICK] != 1) || (s.events[OneButtonBase::EV_LONGPRESSSTART] != 1)) ok = false;
+  if ((s.callbacks != 2) || (s.callbackMaxUs != 250) || (s.callbackTotalUs != 500)) ok = false;
+  if (s.transitions[OneButtonBase::OCS_PRESS] == 0) ok = false;
+  printf("stats: %lu ticks, longest gap %lu msecs, %lu bounces, %lu callbacks in %lu usecs\n",
+         s.ticks, s.maxTickGapMs, s.bounces, s.callbacks, s.callbackTotalUs);
+
+  b.resetStats();
+  if ((b.stats().ticks != 0) || (b.stats().callbacks != 0)) ok = false;
+  return ok;
+}  // checkStats()
+
+
+// ----- Tentative clicks -----
+
+static std::vector<OneButtonEvent> tentativeEvents;
+
+static void recordTentative(const OneButtonEvent &e) {
+  tentativeEvents.push_back(e);
+}
+
+// click the button with the given number of presses of 100 msecs and return the recorded event types.
+static std::string tentativeClicks(OneButtonFull &b, int clicks) {
+  std::string types;
+  tentativeEvents.clear();
+  b.reset();
+  for (unsigned long ms = 1; ms < 2000; ms++) b.tickAt((ms >= 100) && (ms < 100 + 200 * clicks) && (ms % 200 < 100), ms);
+  for (const OneButtonEvent &e : tentativeEvents) types += eventNames[e.event] + std::string(" ");
+  return types;
+}
+
+static bool checkTentative() {
+  OneButtonFull b;
+  bool ok = true;
+
+  ArduinoHost::reset();
+  b.setDebounceMs(20);
+  b.setClickMs(400);
+  b.attachClick(recordTentative);
+  b.attachDoubleClick(recordTentative);
+  b.attachTentativeClick(recordTentative);
+  b.attachClickSuperseded(recordTentative);
+
+  // a single click confirms the tentative click after the click time.
+  std::string types = tentativeClicks(b, 1);
+  if ((types != "tentative click ") || (tentativeEvents[1].time - tentativeEvents[0].time < 400)) ok = false;
+  printf("tentative: single click: %s\n", types.c_str());
+
+  // a double click supersedes the tentative click at the second press.
+  types = tentativeClicks(b, 2);
+  if ((types != "tentative super double ") || (tentativeEvents[1].time - tentativeEvents[0].time > 200)) ok = false;
+  printf("tentative: double click: %s\n", types.c_str());
+  return ok;
+}  // checkTentative()
+
+
+// ----- Resistor ladder decoded by the analog set -----
+
+static int analogClicks[3];
+
+static void countAnalogClick(void *n) {
+  analogClicks[(intptr_t)n]++;
+}
+
+static bool checkAnalogSet() {
+  OneButton buttons[3];
+  OneButtonAnalogSet set(14);
+  bool ok = true;
+
+  ArduinoHost::reset();
+  set.setDebounceMs(20);
+  set.setHysteresis(8);
+  for (int n = 0; n < 3; n++) {
+    analogClicks[n] = 0;
+    buttons[n].attachClick(countAnalogClick, (void *)(intptr_t)n);
+  }
+  set.addButton(&buttons[0], 100);
+  set.addButton(&buttons[1], 300);
+  set.addButton(&buttons[2], 600);
+  set.addCombination(200, 0x03);
+
+  // the entry is kept up to the middle to the next entry plus the hysteresis.
+  const int samples[] = { 1023, 305, 455, 460, 445, 440, 210, 1000 };
+  const uint8_t masks[] = { 0x00, 0x02, 0x02, 0x04, 0x04, 0x02, 0x03, 0x00 };
+  for (int n = 0; n < 8; n++) {
+    set.tick(samples[n]);
+    if (set.decodedMask() != masks[n]) ok = false;
+  }
+
+  // a voltage falling from idle to the first button within 10 msecs is not taken over on the way.
+  set.reset();
+  for (int value = 1023; value >= 100; value -= 100) {
+    ArduinoHost::advanceMillis(1);
+    set.tick(value);
+    if (set.pressedMask() != 0) ok = false;
+  }
+
+  // a click of the second button read from the pin.
+  for (int ms = 0; ms < 1000; ms++) {
+    ArduinoHost::setAnalogValue(14, ((ms >= 100) && (ms < 250)) ? 300 : 1023);
+    ArduinoHost::advanceMillis(1);
+    set.tick();
+  }
+  if ((analogClicks[0] != 0) || (analogClicks[1] != 1) || (analogClicks[2] != 0)) ok = false;
+  return ok;
+}  // checkAnalogSet()
+
+
+// ----- Chords of buttons -----
+
+static int chordClicks[3];
+static int chordCalls = 0;
+
+static void countChordClick(void *n) {
+  chordClicks[(intptr_t)n]++;
+}
+
+static void countChord() {
+  chordCalls++;
+}
+
+// press the buttons A, B and C from the given msecs to 400 msecs and return the clicks of A, B and C and the chords.
+static std::string chordPresses(OneButtonChord &chord, int a, int b, int c) {
+  char result[32];
+  bool active = false;
+  chordCalls = 0;
+  for (int n = 0; n < 3; n++) chordClicks[n] = 0;
+  chord.reset();
+  for (int ms = 0; ms < 1500; ms++) {
+    ArduinoHost::advanceMillis(1);
+    chord.tick(((ms >= a) && (ms < 400) ? 0x01 : 0) | ((ms >= b) && (ms < 400) ? 0x02 : 0) | ((ms >= c) && (ms < 400) ? 0x04 : 0));
+    if (chord.activeChord() == 0x03) active = true;
+  }
+  snprintf(result, sizeof(result), "%d %d %d %d%s", chordClicks[0], chordClicks[1], chordClicks[2], chordCalls, active ? " active" : "");
+  return result;
+}
+
+static bool checkChord() {
+  OneButton buttons[3];
+  OneButtonChord chord;
+  bool ok = true;
+
+  ArduinoHost::reset();
+  for (int n = 0; n < 3; n++) {
+    buttons[n].attachClick(countChordClick, (void *)(intptr_t)n);
+    chord.addButton(&buttons[n]);
+  }
+  chord.setChordMs(80);
+  chord.addChord(0x03, countChord);
+
+  std::string found = chordPresses(chord, 100, 130, 9999);  // the chord A+B.
+  if (found != "0 0 0 1 active") ok = false;
+  printf("chord: clicks of A, B, C and chords: %s\n", found.c_str());
+  if (chordPresses(chord, 100, 9999, 9999) != "1 0 0 0") ok = false;  // A only.
+  if (chordPresses(chord, 100, 300, 9999) != "1 1 0 0") ok = false;   // B pressed too late.
+  if (chordPresses(chord, 9999, 9999, 100) != "0 0 1 0") ok = false;  // C is in no chord.
+  return ok;
+}  // checkChord()
+
+
+// ----- Gestures of short and long presses -----
+
+static std::string gestures;
+
+static void addGesture(void *name) {
+  gestures += (const char *)name;
+}
+
+static void addUnknown() {
+  gestures += "?";
+}
+
+static bool checkGesture() {
+  OneButtonGesture g;
+  bool ok = true;
+
+  ArduinoHost::reset();
+  g.setLongMs(400);
+  g.setPauseMs(800);
+  if (!g.addPattern(". - .", addGesture, (void *)"R") || !g.addPattern("..", addGesture, (void *)"I")
+      || !g.addPattern("-", addGesture, (void *)"T")) ok = false;
+  if (g.addPattern(".-.", addGesture, (void *)"X") || g.addPattern(" ", addGesture, (void *)"X")) ok = false;  // added or empty.
+  g.attachUnknown(addUnknown);
+
+  // presses given with their duration.
+  const unsigned long sequences[][4] = { { 100, 500, 100, 0 }, { 100, 100, 0 }, { 500, 0 }, { 100, 0 }, { 100, 500, 0 }, { 500, 500, 500, 0 } };
+  gestures = "";
+  for (const unsigned long *seq : sequences) {
+    for (int n = 0; seq[n]; n++) g.addPress(seq[n]);
+    g.endSequence();
+  }
+  if (gestures != "RIT???") ok = false;
+  printf("gesture: %s\n", gestures.c_str());
+
+  // a short, long and short press given by the levels ends after the pause.
+  gestures = "";
+  g.reset();
+  for (int ms = 0; ms < 3000; ms++) {
+    ArduinoHost::advanceMillis(1);
+    g.tick(((ms >= 100) && (ms < 200)) || ((ms >= 400) && (ms < 1000)) || ((ms >= 1200) && (ms < 1300)));
+    if ((ms == 2000) && (gestures != "")) ok = false;  // waiting for the pause.
+  }
+  if ((gestures != "R") || (g.getPressCount() != 0)) ok = false;
+  return ok;
+}  // checkGesture()
+
+
+// ----- Clock policies -----
+
+struct MicrosConfig : OneButtonConfig {
+  typedef OneButtonClockMicros clock_type;
+  typedef OneButtonDebounceTime<time_type> debounce_type;
+};
+
+struct Millis64Config : OneButtonConfig {
+  typedef uint64_t time_type;
+  typedef OneButtonDebounceAdaptive<time_type, uint16_t> debounce_type;
+  typedef OneButtonClockMillis64 clock_type;
+};
+
+static int clockPresses = 0;
+static int clockClicks = 0;
+static unsigned long clockLongMs = 0;
+
+static void countClockPress() {
+  clockPresses++;
+}
+
+static void countClockClick() {
+  clockClicks++;
+}
+
+template<class BUTTON>
+static void stopClockLong(void *b) {
+  clockLongMs = ((BUTTON *)b)->getPressedMs();
+}
+
+// tick the button with the level for the given usecs in steps of the host clock.
+template<class BUTTON>
+static void holdClock(BUTTON &b, bool level, unsigned long us, unsigned long stepUs) {
+  for (unsigned long t = 0; t < us; t += stepUs) {
+    ArduinoHost::advanceMicros(stepUs);
+    b.tick(level);
+  }
+}
+
+static bool checkClocks() {
+  bool ok = true;
+
+  // a press of 2 msecs and a glitch of 200 usecs sampled every 50 usecs.
+  OneButtonT<MicrosConfig> fast;
+  ArduinoHost::reset();
+  fast.setDebounceUs(300);
+  fast.attachPress(countClockPress);
+  fast.attachClick(countClockClick);
+  holdClock(fast, false, 1000, 50);
+  holdClock(fast, true, 2000, 50);
+  holdClock(fast, false, 1000, 50);
+  holdClock(fast, true, 200, 50);
+  holdClock(fast, false, 1000000, 50);
+  if ((clockPresses != 1) || (clockClicks != 1)) ok = false;
+  printf("clocks: micros: %d presses, %d clicks\n", clockPresses, clockClicks);
+
+  // a long press of 1400 msecs from 256 msecs before the wrap of millis() to 32 bits.
+  OneButtonT<Millis64Config> slow;
+  ArduinoHost::reset();
+  ArduinoHost::setMillis(0xFFFFFF00UL - 100);
+  slow.attachLongPressStop(stopClockLong<OneButtonT<Millis64Config>>, &slow);
+  holdClock(slow, false, 100000, 1000);
+  holdClock(slow, true, 1400000, 1000);
+  holdClock(slow, false, 1000000, 1000);
+  if ((clockLongMs < 1300) || (clockLongMs > 1400)) ok = false;
+  printf("clocks: millis64: long press of %lu msecs\n", clockLongMs);
+  return ok;
+}  // checkClocks()
+
+
+// ----- Batch ticks compared to single ticks -----
+
+#define TICKALL_BUTTONS 40
+
+// add the event and the time to the log given as parameter.
+template<int EVENT>
+static void logTickAll(void *log) {
+  char line[32];
+  snprintf(line, sizeof(line), "%s@%lu ", eventNames[EVENT], millis());
+  *(std::string *)log += line;
+}
+
+static void attachTickAll(OneButton &b, std::string *log) {
+  b.attachClick(logTickAll<OneButtonBase::EV_CLICK>, log);
+  b.attachDoubleClick(logTickAll<OneButtonBase::EV_DOUBLECLICK>, log);
+  b.attachLongPressStart(logTickAll<OneButtonBase::EV_LONGPRESSSTART>, log);
+  b.attachLongPressStop(logTickAll<OneButtonBase::EV_LONGPRESSSTOP>, log);
+}
+
+static bool checkTickAll() {
+  std::mt19937 rnd(2020);
+  OneButton batched[TICKALL_BUTTONS], single[TICKALL_BUTTONS];
+  std::string batchedLog[TICKALL_BUTTONS], singleLog[TICKALL_BUTTONS];
+  std::vector<bool> levels[TICKALL_BUTTONS];
+  bool ok = true;
+
+  ArduinoHost::reset();
+  for (int n = 0; n < TICKALL_BUTTONS; n++) {
+    attachTickAll(batched[n], &batchedLog[n]);
+    attachTickAll(single[n], &singleLog[n]);
+    levels[n] = randomLevels(rnd);
+  }
+
+  for (size_t ms = 0; ms < 30000; ms++) {
+    uint32_t words[(TICKALL_BUTTONS + 31) / 32] = {};
+    ArduinoHost::advanceMillis(1);
+    for (int n = 0; n < TICKALL_BUTTONS; n++) {
+      if (levels[n][ms]) words[n / 32] |= (uint32_t)1 << (n % 32);
+      single[n].tick(levels[n][ms]);
+    }
+    OneButton::tickAll(batched, TICKALL_BUTTONS, words);
+  }
+
+  for (int n = 0; n < TICKALL_BUTTONS; n++) {
+    if (singleLog[n].empty() || (batchedLog[n] != singleLog[n])) {
+      printf("tickall: button %d differs\n  expected: %s\n  found:    %s\n", n, singleLog[n].c_str(), batchedLog[n].c_str());
+      ok = false;
+      break;
+    }
+  }
+  return ok;
+}  // checkTickAll()
+
+
+// ----- Auto repeat -----
+
+struct RepeatLog {
+  OneButton *button;
+  std::vector<unsigned long> times;  // times of the DuringLongPress events.
+  int repeats;                       // the sum of the repeat counts.
+};
+
+static unsigned long repeatMs = 0;
+
+static void logRepeat(void *p) {
+  RepeatLog *log = (RepeatLog *)p;
+  log->times.push_back(repeatMs);
+  log->repeats += log->button->getRepeatCount();
+}
+
+static bool checkAutoRepeat() {
+  OneButton polled, late;
+  RepeatLog polledLog = { &polled, {}, 0 }, lateLog = { &late, {}, 0 };
+  int polledRepeats = 0, lateRepeats = 0;
+  bool ok = true;
+
+  ArduinoHost::reset();
+  for (OneButton *b : { &polled, &late }) {
+    b->setDebounceMs(20);
+    b->setPressMs(800);
+    b->setAutoRepeat(500, 200, 50, 1000);
+  }
+  polled.attachDuringLongPress(logRepeat, &polledLog);
+  late.attachDuringLongPress(logRepeat, &lateLog);
+
+  // a press from 100 to 6000 msecs, the late button is ticked every 300 msecs after the first repeat.
+  // The repeats are compared at the last tick of both buttons before the release.
+  for (repeatMs = 1; repeatMs < 7000; repeatMs++) {
+    bool level = (repeatMs >= 100) && (repeatMs <= 6000);
+    polled.tickAt(level, repeatMs);
+    if (lateLog.times.empty() || (repeatMs % 300 == 0)) late.tickAt(level, repeatMs);
+    if (repeatMs == 6000) {
+      polledRepeats = polledLog.repeats;
+      lateRepeats = lateLog.repeats;
+    }
+  }
+
+  // the first repeat after the delay, then shrinking intervals down to 50 msecs.
+  const std::vector<unsigned long> &t = polledLog.times;
+  if ((t.size() < 10) || (t[0] != 100 + 20 + 800 + 1 + 500) || (polledLog.repeats != (int)t.size())) ok = false;
+  for (size_t n = 2; ok && (n < t.size()); n++) {
+    if ((t[n] - t[n - 1] > t[n - 1] - t[n - 2]) || (t[n] - t[n - 1] < 50)) ok = false;
+  }
+  if (ok && ((t[1] - t[0] != 200) || (t.back() - t[t.size() - 2] != 50))) ok = false;
+
+  // the late ticks coalesce the repeats.
+  if ((lateLog.times.size() >= t.size()) || (lateRepeats != polledRepeats)) ok = false;
+  printf("autorepeat: %u events with %d repeats, %u late events with %d repeats\n",
+         (unsigned)t.size(), polledRepeats, (unsigned)lateLog.times.size(), lateRepeats);
+  return ok;
+}  // checkAutoRepeat()
+
+
+// ----- Buttons of an input source -----
+
+#define INPUTGROUP_BUTTONS 16
+
+// A source with the raw levels of 16 inputs that can be made busy.
+class CheckSource : public OneButtonInputSource {
+public:
+  uint32_t levels = 0xFFFF;
+  bool busy = false;
+
+  bool read(uint32_t &l) {
+    if (busy) return false;
+    l = levels;
+    return true;
+  };
+};
+
+static bool checkInputGroup() {
+  std::mt19937 rnd(2525);
+  CheckSource source;
+  OneButtonInputGroup group(&source);
+  OneButton grouped[INPUTGROUP_BUTTONS], polled[INPUTGROUP_BUTTONS];
+  std::string groupedLog[INPUTGROUP_BUTTONS], polledLog[INPUTGROUP_BUTTONS];
+  std::vector<bool> levels[INPUTGROUP_BUTTONS];
+  bool ok = true;
+
+  ArduinoHost::reset();
+  group.setActiveLowMask(0xFFFF);
+  for (int n = 0; n < INPUTGROUP_BUTTONS; n++) {
+    attachTickAll(grouped[n], &groupedLog[n]);
+    attachTickAll(polled[n], &polledLog[n]);
+    group.attach(n, &grouped[n]);
+    levels[n] = randomLevels(rnd);
+  }
+  if (!group.begin()) ok = false;
+
+  for (size_t ms = 0; ms < 30000; ms++) {
+    ArduinoHost::advanceMillis(1);
+    source.levels = 0xFFFF;
+    for (int n = 0; n < INPUTGROUP_BUTTONS; n++) {
+      if (levels[n][ms]) source.levels &= ~((uint32_t)1 << n);
+      polled[n].tick(levels[n][ms]);
+    }
+    group.tick();
+  }
+  if (group.getReads() != 30000) ok = false;
+
+  for (int n = 0; n < INPUTGROUP_BUTTONS; n++) {
+    if (polledLog[n].empty() || (groupedLog[n] != polledLog[n])) {
+      printf("inputgroup: button %d differs\n  expected: %s\n  found:    %s\n", n, polledLog[n].c_str(), groupedLog[n].c_str());
+      ok = false;
+      break;
+    }
+  }
+
+  // a press of the first button is kept while the source is busy.
+  group.reset();
+  groupedLog[0].clear();
+  for (int ms = 0; ms < 2000; ms++) {
+    ArduinoHost::advanceMillis(1);
+    source.levels = ((ms >= 100) && (ms < 300)) ? 0xFFFE : 0xFFFF;
+    source.busy = (ms >= 150) && (ms < 1000);
+    group.tick();
+  }
+  if (groupedLog[0].compare(0, 6, "start@") != 0) ok = false;
+  return ok;
+}  // checkInputGroup()
+
+
+int main(int argc, char *argv[]) {
+  const char *check = (argc > 1) ? argv[1] : "all";
+  int rounds = (argc > 2) ? atoi(argv[2]) : 20;
+  bool all = (strcmp(check, "all") == 0);
+  bool ok = true;
+
+  if (all || (strcmp(check, "edges") == 0)) {
+    bool r = checkEdges(rounds);
+    printf("edges: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "glitch") == 0)) {
+    bool r = checkGlitch();
+    printf("glitch: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "detach") == 0)) {
+    bool r = checkDetach();
+    printf("detach: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "trace") == 0)) {
+    bool r = checkTrace();
+    printf("trace: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "table") == 0)) {
+    bool r = checkTable(rounds);
+    printf("table: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "userfsm") == 0)) {
+    bool r = checkUserFsm();
+    printf("userfsm: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "bank") == 0)) {
+    bool r = checkBank(rounds);
+    printf("bank: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "queue") == 0)) {
+    bool r = checkQueue(rounds);
+    printf("queue: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "deadline") == 0)) {
+    bool r = checkDeadline(rounds);
+    printf("deadline: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "stats") == 0)) {
+    bool r = checkStats();
+    printf("stats: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "tentative") == 0)) {
+    bool r = checkTentative();
+    printf("tentative: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "analogset") == 0)) {
+    bool r = checkAnalogSet();
+    printf("analogset: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "chord") == 0)) {
+    bool r = checkChord();
+    printf("chord: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "gesture") == 0)) {
+    bool r = checkGesture();
+    printf("gesture: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "clocks") == 0)) {
+    bool r = checkClocks();
+    printf("clocks: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "tickall") == 0)) {
+    bool r = checkTickAll();
+    printf("tickall: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "autorepeat") == 0)) {
+    bool r = checkAutoRepeat();
+    printf("autorepeat: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  if (all || (strcmp(check, "inputgroup") == 0)) {
+    bool r = checkInputGroup();
+    printf("inputgroup: %s\n", r ? "OK" : "FAILED");
+    ok = ok && r;
+  }
+  return ok ? 0 : 1;
+}  // main()
+
+
+// end.
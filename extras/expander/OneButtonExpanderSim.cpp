@@ -0,0 +1,259 @@
+/**
+ * @file OneButtonExpanderSim.cpp
+ *
+ * @brief Host simulation of 32 buttons on two simulated I2C port expanders read by OneButtonInputGroup.
+ *
+ * 16 buttons are connected to a simulated MCP23017 that is read synchronously by OneButtonMCP23017.
+ * 16 buttons are connected to a simulated PCF8575 read by OneButtonPCF8574 through an asynchronous
+ * source that delivers the levels of a transfer some msecs after the request.
+ * Random keys are clicked with bouncing contacts. All clicks must be detected and every read of
+ * 16 inputs must be one bus transaction instead of one transaction per button.
+ *
+ * Usage: OneButtonExpanderSim [rounds]
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ */
+
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "OneButton.h"
+#include "OneButtonExpander.h"
+
+#define SIM_KEYS 32
+#define SIM_TICK_MS 2      // the main loop is busy with other things in between.
+#define SIM_LATENCY_MS 3   // duration of an asynchronous transfer.
+
+#define SIM_MCP_ADDRESS 0x20
+#define SIM_PCF_ADDRESS 0x21
+
+
+// ----- Simulated expanders -----
+
+// MCP23017 with sequential register access, the GPIO registers read the pins.
+class SimMCP23017 : public ArduinoHost::WireDevice {
+public:
+  uint16_t pressed = 0;  // buttons connecting a pin to GND.
+
+  SimMCP23017() {
+    memset(_regs, 0, sizeof(_regs));
+    _regs[OneButtonMCP23017::REG_IODIRA] = _regs[OneButtonMCP23017::REG_IODIRA + 1] = 0xFF;
+  };
+
+  void receive(const uint8_t *data, uint8_t length) {
+    if (length == 0) return;
+    _pointer = data[0];
+    for (uint8_t n = 1; n < length; n++) _regs[_pointer++ % sizeof(_regs)] = data[n];
+  };
+
+  uint8_t request(uint8_t *data, uint8_t length) {
+    for (uint8_t n = 0; n < length; n++) {
+      uint8_t reg = _pointer++ % sizeof(_regs);
+      data[n] = _regs[reg];
+      if ((reg & 0xFE) == OneButtonMCP23017::REG_GPIOA) data[n] = _port(reg & 1);
+    }
+    return length;
+  };
+
+private:
+  uint8_t _regs[0x16];
+  uint8_t _pointer = 0;
+
+  // open inputs read HIGH only with the pullup enabled.
+  uint8_t _port(int n) {
+    uint8_t pullup = _regs[OneButtonMCP23017::REG_GPPUA + n];
+    return pullup & ~(uint8_t)(pressed >> (8 * n));
+  };
+};
+
+
+// PCF8575 with quasi bidirectional pins: a pin reads HIGH when written HIGH and not pressed.
+class SimPCF8575 : public ArduinoHost::WireDevice {
+public:
+  uint16_t pressed = 0;
+
+  void receive(const uint8_t *data, uint8_t length) {
+    if (length >= 2) _latch = data[0] | (data[1] << 8);
+  };
+
+  uint8_t request(uint8_t *data, uint8_t length) {
+    uint16_t levels = _latch & ~pressed;
+    for (uint8_t n = 0; n < length; n++) data[n] = (uint8_t)(levels >> (8 * n));
+    return length;
+  };
+
+private:
+  uint16_t _latch = 0;
+};
+
+
+// A source delivering the levels of another source SIM_LATENCY_MS after the request.
+class SimAsyncSource : public OneButtonInputSource {
+public:
+  explicit SimAsyncSource(OneButtonInputSource *source)
+    : _source(source){};
+
+  bool begin(void) {
+    return _source->begin();
+  };
+
+  void request(void) {
+    _start = millis();
+    _busy = true;
+  };
+
+  bool read(uint32_t &levels) {
+    if (!_busy || (millis() - _start < SIM_LATENCY_MS)) return false;
+    _busy = false;
+    return _source->read(levels);
+  };
+
+private:
+  OneButtonInputSource *_source;
+  unsigned long _start = 0;
+  bool _busy = false;
+};
+
+
+// ----- Simulation -----
+
+static SimMCP23017 mcpDevice;
+static SimPCF8575 pcfDevice;
+
+static OneButtonMCP23017 mcp(SIM_MCP_ADDRESS);
+static OneButtonPCF8574 pcf(SIM_PCF_ADDRESS, 16);
+static SimAsyncSource pcfAsync(&pcf);
+
+static OneButtonInputGroup mcpGroup(&mcp);
+static OneButtonInputGroup pcfGroup(&pcfAsync);
+
+static unsigned long clicks[SIM_KEYS];
+static unsigned long longPresses[SIM_KEYS];
+
+
+static void setKey(int key, bool down) {
+  uint16_t &pressed = (key < 16) ? mcpDevice.pressed : pcfDevice.pressed;
+  uint16_t bit = (uint16_t)1 << (key % 16);
+  pressed = down ? (pressed | bit) : (pressed & ~bit);
+}
+
+
+static void onClick(void *param) {
+  clicks[(intptr_t)param]++;
+}
+
+static void onLongPressStart(void *param) {
+  longPresses[(intptr_t)param]++;
+}
+
+
+static unsigned long ms = 0;
+static unsigned long ticks = 0;
+
+// let the time pass and tick the groups every SIM_TICK_MS.
+static void run(unsigned long duration) {
+  while (duration--) {
+    ArduinoHost::advanceMillis(1);
+    if (++ms % SIM_TICK_MS == 0) {
+      mcpGroup.tick();
+      pcfGroup.tick();
+      ticks++;
+    }
+  }
+}
+
+// press or release a key with some bouncing.
+static void bounceKey(int key, bool down, std::mt19937 &rnd) {
+  for (int b = rnd() % 4; b > 0; b--) {
+    setKey(key, down);
+    run(1);
+    setKey(key, !down);
+    run(1);
+  }
+  setKey(key, down);
+}
+
+
+int main(int argc, char *argv[]) {
+  int rounds = (argc > 1) ? atoi(argv[1]) : 300;
+  static OneButton buttons[SIM_KEYS];
+
+  ArduinoHost::reset();
+  ArduinoHost::attachWireDevice(SIM_MCP_ADDRESS, &mcpDevice);
+  ArduinoHost::attachWireDevice(SIM_PCF_ADDRESS, &pcfDevice);
+
+  for (intptr_t k = 0; k < SIM_KEYS; k++) {
+    OneButton &b = buttons[k];
+    b.setDebounceMs(10);
+    b.setClickMs(150);
+    b.setPressMs(400);
+    b.attachClick(onClick, (void *)k);
+    b.attachLongPressStart(onLongPressStart, (void *)k);
+    if (k < 16) {
+      mcpGroup.attach(k, &b);
+    } else {
+      pcfGroup.attach(k - 16, &b);
+    }
+  }
+  mcpGroup.setActiveLowMask(0xFFFF);
+  pcfGroup.setActiveLowMask(0xFFFF);
+
+  bool ok = mcpGroup.begin() && pcfGroup.begin();
+  unsigned long startTransactions = ArduinoHost::wireTransactions();
+
+  std::mt19937 rnd(42);
+  unsigned long expectedClicks[SIM_KEYS] = {};
+
+  run(100);
+  for (int n = 0; n < rounds; n++) {
+    // 1...3 different keys together.
+    int count = 1 + rnd() % 3;
+    int keys[3];
+    for (int i = 0; i < count; i++) {
+      keys[i] = rnd() % SIM_KEYS;
+      for (int j = 0; j < i; j++) {
+        if (keys[j] == keys[i]) keys[i] = (keys[i] + 16 + 1) % SIM_KEYS;
+      }
+    }
+    for (int i = 0; i < count; i++) bounceKey(keys[i], true, rnd);
+    run(60 + rnd() % 40);
+    for (int i = 0; i < count; i++) {
+      bounceKey(keys[i], false, rnd);
+      expectedClicks[keys[i]]++;
+    }
+    run(300);
+  }
+
+  unsigned long deadline;
+  if (mcpGroup.nextDeadlineMs(deadline) || pcfGroup.nextDeadlineMs(deadline)) ok = false;
+
+  unsigned long total = 0, expectedTotal = 0;
+  for (int k = 0; k < SIM_KEYS; k++) {
+    total += clicks[k];
+    expectedTotal += expectedClicks[k];
+    if (clicks[k] != expectedClicks[k]) ok = false;
+    if (longPresses[k]) ok = false;
+  }
+
+  // every read of 16 inputs is one transaction.
+  unsigned long reads = mcpGroup.getReads() + pcfGroup.getReads();
+  unsigned long transactions = ArduinoHost::wireTransactions() - startTransactions;
+  if (transactions != reads) ok = false;
+
+  printf("%d buttons on 2 expanders, %d rounds, %lu ticks\n", SIM_KEYS, rounds, ticks);
+  printf("clicks %lu of %lu, %lu reads of 16 inputs in %lu bus transactions, %lu with one read per button\n",
+         total, expectedTotal, reads, transactions, ticks * SIM_KEYS);
+  printf("%s\n", ok ? "OK" : "FAILED");
+  return ok ? 0 : 1;
+}  // main()
+
+
+// end.
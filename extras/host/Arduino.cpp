@@ -0,0 +1,161 @@
+/**
+ * @file Arduino.cpp
+ *
+ * @brief Minimal Arduino API shim for compiling the OneButton library on a host system.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ */
+
+#include <chrono>
+
+#include "Arduino.h"
+
+#define HOST_PINS 256
+
+static uint64_t _hostMicros = 0;                     // virtual clock in microseconds.
+static uint8_t _pinLevel[HOST_PINS];                 // simulated pin levels.
+static int _analogValue[HOST_PINS];                  // simulated analog values.
+static ArduinoHost::digitalReadFunction _readFunc = NULL;  // optional simulation of the input levels.
+static void (*_isrFunc[HOST_PINS])(void);            // attached interrupt routines.
+static int _isrMode[HOST_PINS];                      // the level changes calling the interrupt routine.
+
+static bool _realTime = false;                          // the clock follows the real time.
+static std::chrono::steady_clock::time_point _realStart;  // real time when _hostMicros was taken.
+
+// get the current value of the clock.
+static uint64_t _now() {
+  if (_realTime) {
+    return _hostMicros + std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _realStart).count();
+  }
+  return _hostMicros;
+}
+
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  // a pullup input without a pressed button reads HIGH.
+  if (mode == INPUT_PULLUP) _pinLevel[pin] = HIGH;
+}
+
+
+int digitalRead(uint8_t pin) {
+  if (_readFunc) return _readFunc(pin);
+  return _pinLevel[pin];
+}
+
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  _pinLevel[pin] = val ? HIGH : LOW;
+}
+
+
+int analogRead(uint8_t pin) {
+  return _analogValue[pin];
+}
+
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode) {
+  _isrFunc[interruptNum] = userFunc;
+  _isrMode[interruptNum] = mode;
+}
+
+
+void detachInterrupt(uint8_t interruptNum) {
+  _isrFunc[interruptNum] = NULL;
+}
+
+
+// the simulated interrupt routines run in the thread setting the pin level.
+void noInterrupts(void) {}
+void interrupts(void) {}
+
+
+unsigned long millis(void) {
+  return (unsigned long)(_now() / 1000);
+}
+
+
+unsigned long micros(void) {
+  return (unsigned long)_now();
+}
+
+
+// the virtual clock advances by the delay.
+void delayMicroseconds(unsigned int us) {
+  ArduinoHost::advanceMicros(us);
+}
+
+
+// ----- Host simulation interface -----
+
+void ArduinoHost::reset() {
+  _realTime = false;
+  _hostMicros = 0;
+  for (int n = 0; n < HOST_PINS; n++) {
+    _pinLevel[n] = LOW;
+    _analogValue[n] = 0;
+  }
+  _readFunc = NULL;
+  for (int n = 0; n < HOST_PINS; n++) _isrFunc[n] = NULL;
+}
+
+
+void ArduinoHost::setMicros(uint64_t us) {
+  if (_realTime) return;
+  _hostMicros = us;
+}
+
+
+void ArduinoHost::setMillis(unsigned long ms) {
+  if (_realTime) return;
+  _hostMicros = (uint64_t)ms * 1000;
+}
+
+
+void ArduinoHost::advanceMillis(unsigned long ms) {
+  if (_realTime) return;
+  _hostMicros += (uint64_t)ms * 1000;
+}
+
+
+void ArduinoHost::advanceMicros(uint64_t us) {
+  if (_realTime) return;
+  _hostMicros += us;
+}
+
+
+void ArduinoHost::setRealTime(bool enable) {
+  if (enable == _realTime) return;
+  _hostMicros = _now();
+  _realStart = std::chrono::steady_clock::now();
+  _realTime = enable;
+}
+
+
+void ArduinoHost::setPinLevel(uint8_t pin, int level) {
+  uint8_t old = _pinLevel[pin];
+  _pinLevel[pin] = level ? HIGH : LOW;
+
+  if (_isrFunc[pin] && (old != _pinLevel[pin])) {
+    int mode = _isrMode[pin];
+    if ((mode == CHANGE) || ((mode == RISING) && level) || ((mode == FALLING) && !level)) _isrFunc[pin]();
+  }
+}
+
+
+void ArduinoHost::setAnalogValue(uint8_t pin, int value) {
+  _analogValue[pin] = value;
+}
+
+
+void ArduinoHost::setDigitalReadFunction(digitalReadFunction newFunction) {
+  _readFunc = newFunction;
+}
+
+
+// end.
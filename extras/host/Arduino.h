@@ -0,0 +1,115 @@
+// -----
+// Arduino.h - Minimal Arduino API shim for compiling the OneButton library on
+// a host system like Linux. Copyright (c) by Matthias Hertel,
+// http://www.mathertel.de This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// Only the functions used by the library are implemented.
+// The time returned by millis() and micros() is a virtual clock that only
+// advances when the host program sets it or follows the real time when
+// enabled, analogRead() returns the values set by the host program and
+// digitalRead() can be redirected to a function to simulate any
+// input pattern. Setting a pin level calls the interrupt routine
+// attached to the pin when the level changes.
+// -----
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t val);
+int analogRead(uint8_t pin);
+
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(p) (p)
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+void noInterrupts(void);
+void interrupts(void);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delayMicroseconds(unsigned int us);
+
+
+// ----- Host simulation interface -----
+
+namespace ArduinoHost {
+
+typedef int (*digitalReadFunction)(uint8_t pin);
+
+/**
+ * Reset the virtual clock to 0, all pin levels to LOW, all analog values to 0 and remove the digitalRead function
+ * and all interrupt routines.
+ */
+void reset();
+
+/**
+ * Set the virtual clock in microseconds.
+ */
+void setMicros(uint64_t us);
+
+/**
+ * Set the virtual clock in milliseconds.
+ */
+void setMillis(unsigned long ms);
+
+/**
+ * Advance the virtual clock by the given number of milliseconds.
+ */
+void advanceMillis(unsigned long ms);
+
+/**
+ * Advance the virtual clock by the given number of microseconds.
+ */
+void advanceMicros(uint64_t us);
+
+/**
+ * Let the clock follow the real time starting at the current value, e.g. for
+ * running buttons in threads. Setting or advancing the clock is ignored meanwhile.
+ */
+void setRealTime(bool enable);
+
+/**
+ * Set the level returned by digitalRead() for the given pin.
+ * An attached interrupt routine is called like on a real pin when the level changes.
+ */
+void setPinLevel(uint8_t pin, int level);
+
+/**
+ * Set the value returned by analogRead() for the given pin.
+ */
+void setAnalogValue(uint8_t pin, int value);
+
+/**
+ * Redirect all digitalRead() calls to the given function.
+ * Pass NULL to use the levels set by setPinLevel() again.
+ */
+void setDigitalReadFunction(digitalReadFunction newFunction);
+
+}  // namespace ArduinoHost
+
+#endif
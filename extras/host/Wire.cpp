@@ -0,0 +1,82 @@
+/**
+ * @file Wire.cpp
+ *
+ * @brief Minimal Arduino Wire (I2C) API shim passing the transfers to simulated devices.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ */
+
+#include "Wire.h"
+
+#define WIRE_ADDRESSES 128
+
+TwoWire Wire;
+
+static ArduinoHost::WireDevice *_devices[WIRE_ADDRESSES];  // simulated devices.
+static unsigned long _transactions = 0;                     // transactions ended by a stop condition.
+
+
+void TwoWire::beginTransmission(uint8_t address) {
+  _address = address;
+  _txLength = 0;
+}
+
+
+size_t TwoWire::write(uint8_t data) {
+  if (_txLength >= WIRE_BUFFER_SIZE) return 0;
+  _txBuffer[_txLength++] = data;
+  return 1;
+}
+
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  ArduinoHost::WireDevice *d = _devices[_address & 0x7F];
+  if (sendStop) _transactions++;
+  if (!d) return 2;  // address not acknowledged.
+
+  d->receive(_txBuffer, _txLength);
+  _txLength = 0;
+  return 0;
+}
+
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity) {
+  ArduinoHost::WireDevice *d = _devices[address & 0x7F];
+  _transactions++;
+  _rxIndex = 0;
+  _rxLength = 0;
+  if (d) _rxLength = d->request(_rxBuffer, min(quantity, (uint8_t)WIRE_BUFFER_SIZE));
+  return _rxLength;
+}
+
+
+int TwoWire::available(void) {
+  return _rxLength - _rxIndex;
+}
+
+
+int TwoWire::read(void) {
+  if (_rxIndex >= _rxLength) return -1;
+  return _rxBuffer[_rxIndex++];
+}
+
+
+// ----- Host simulation interface -----
+
+void ArduinoHost::attachWireDevice(uint8_t address, WireDevice *device) {
+  _devices[address & 0x7F] = device;
+}
+
+
+unsigned long ArduinoHost::wireTransactions() {
+  return _transactions;
+}
+
+
+// end.
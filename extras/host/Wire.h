@@ -0,0 +1,92 @@
+// -----
+// Wire.h - Minimal Arduino Wire (I2C) API shim for compiling the OneButton
+// library on a host system like Linux. Copyright (c) by Matthias Hertel,
+// http://www.mathertel.de This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// Only the master functions used by the library are implemented.
+// The transfers are passed to simulated devices attached to an address by the
+// host program. Every stop condition ends a bus transaction, a repeated start
+// by endTransmission(false) continues it.
+// -----
+
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include "Arduino.h"
+
+#define WIRE_BUFFER_SIZE 32
+
+
+class TwoWire {
+public:
+  void begin(void){};
+  void setClock(uint32_t){};
+
+  void beginTransmission(uint8_t address);
+  size_t write(uint8_t data);
+
+  /**
+   * Send the written data to the device.
+   * @return 0 on success, 2 when no device has the address.
+   */
+  uint8_t endTransmission(bool sendStop = true);
+
+  /**
+   * Read from the device into the receive buffer.
+   * @return The number of bytes received.
+   */
+  uint8_t requestFrom(uint8_t address, uint8_t quantity);
+
+  int available(void);
+  int read(void);
+
+private:
+  uint8_t _address = 0;
+  uint8_t _txBuffer[WIRE_BUFFER_SIZE];
+  uint8_t _txLength = 0;
+  uint8_t _rxBuffer[WIRE_BUFFER_SIZE];
+  uint8_t _rxLength = 0;
+  uint8_t _rxIndex = 0;
+};
+
+extern TwoWire Wire;
+
+
+// ----- Host simulation interface -----
+
+namespace ArduinoHost {
+
+/**
+ * A simulated I2C device.
+ */
+class WireDevice {
+public:
+  virtual ~WireDevice(){};
+
+  /**
+   * Receive the data written by the master.
+   */
+  virtual void receive(const uint8_t *data, uint8_t length) = 0;
+
+  /**
+   * Send data requested by the master.
+   * @return The number of bytes sent.
+   */
+  virtual uint8_t request(uint8_t *data, uint8_t length) = 0;
+};
+
+/**
+ * Attach a simulated device to an address or detach it by NULL.
+ */
+void attachWireDevice(uint8_t address, WireDevice *device);
+
+/**
+ * @return The number of bus transactions ended by a stop condition.
+ */
+unsigned long wireTransactions();
+
+}  // namespace ArduinoHost
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @file OneButtonPinGroupSim.cpp
+ *
+ * @brief Host simulation of 64 buttons in 2 OneButtonPinGroup instances driven by simulated interrupts.
+ *
+ * The first group reads the pins of its 32 buttons in the interrupt routine that is called by
+ * the host shim on every level change. The second group reads a simulated 32 bit port register
+ * by a reader function and its interrupt routine is called when the port changes. Random keys
+ * are clicked with bouncing contacts while the main loop ticks every few msecs. All clicks must
+ * be detected and only the changed and pending buttons may be advanced by tick().
+ *
+ * Usage: OneButtonPinGroupSim [rounds]
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ */
+
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Arduino.h"
+#include "OneButton.h"
+#include "OneButtonPinGroup.h"
+
+#define SIM_KEYS 64
+#define SIM_PIN0 20       // pin of the first button in the pin group.
+#define SIM_TICK_MS 5     // the main loop is busy with other things in between.
+
+static OneButtonPinGroup pinGroup;
+static OneButtonPinGroup portGroup;
+
+static uint32_t port = 0;  // the simulated port register of the second group.
+static unsigned long isrCalls = 0;
+static unsigned long clicks[SIM_KEYS];
+static unsigned long longPresses[SIM_KEYS];
+
+
+static uint32_t readPort() {
+  return port;
+}
+
+// the pin change interrupt of the port.
+static void setPort(uint32_t levels) {
+  if (levels != port) {
+    port = levels;
+    portGroup.isr();
+    isrCalls++;
+  }
+}
+
+// the interrupt routine of the pin group is called by the host shim on a level change.
+static void setKey(int key, bool down) {
+  if (key < 32) {
+    if (digitalRead(SIM_PIN0 + key) != (down ? LOW : HIGH)) isrCalls++;
+    ArduinoHost::setPinLevel(SIM_PIN0 + key, down ? LOW : HIGH);
+  } else {
+    uint32_t bit = (uint32_t)1 << (key - 32);
+    setPort(down ? (port | bit) : (port & ~bit));
+  }
+}
+
+
+static void onClick(void *param) {
+  clicks[(intptr_t)param]++;
+}
+
+static void onLongPressStart(void *param) {
+  longPresses[(intptr_t)param]++;
+}
+
+
+static unsigned long ms = 0;
+static unsigned long ticks = 0;
+static unsigned long dueLanes = 0;
+
+// let the time pass and tick the groups every SIM_TICK_MS.
+static void run(unsigned long duration) {
+  while (duration--) {
+    ArduinoHost::advanceMillis(1);
+    if (++ms % SIM_TICK_MS == 0) {
+      dueLanes += __builtin_popcount(pinGroup.dueMask()) + __builtin_popcount(portGroup.dueMask());
+      pinGroup.tick();
+      portGroup.tick();
+      ticks++;
+    }
+  }
+}
+
+// press or release a key with some bouncing.
+static void bounceKey(int key, bool down, std::mt19937 &rnd) {
+  for (int b = rnd() % 4; b > 0; b--) {
+    setKey(key, down);
+    run(1);
+    setKey(key, !down);
+    run(1);
+  }
+  setKey(key, down);
+}
+
+
+int main(int argc, char *argv[]) {
+  int rounds = (argc > 1) ? atoi(argv[1]) : 300;
+  static OneButton buttons[SIM_KEYS];
+
+  ArduinoHost::reset();
+
+  for (intptr_t k = 0; k < SIM_KEYS; k++) {
+    OneButton &b = buttons[k];
+    if (k < 32) b.setup(SIM_PIN0 + k, INPUT_PULLUP, true);
+    b.setDebounceMs(10);
+    b.setClickMs(150);
+    b.setPressMs(400);
+    b.attachClick(onClick, (void *)k);
+    b.attachLongPressStart(onLongPressStart, (void *)k);
+    if (k < 32) {
+      pinGroup.attach(k, &b);
+    } else {
+      portGroup.attach(k - 32, &b);
+    }
+  }
+  portGroup.setReader(readPort);
+
+  bool ok = pinGroup.begin() && portGroup.begin();
+
+  std::mt19937 rnd(42);
+  unsigned long expectedClicks[SIM_KEYS] = {};
+
+  run(100);
+  for (int n = 0; n < rounds; n++) {
+    // 1...3 keys together, one of them is in the other group.
+    int count = 1 + rnd() % 3;
+    int keys[3];
+    for (int i = 0; i < count; i++) {
+      keys[i] = rnd() % SIM_KEYS;
+      for (int j = 0; j < i; j++) {
+        if (keys[j] == keys[i]) keys[i] = (keys[i] + 32 + 1) % SIM_KEYS;
+      }
+    }
+    for (int i = 0; i < count; i++) bounceKey(keys[i], true, rnd);
+    run(60 + rnd() % 40);
+    for (int i = 0; i < count; i++) {
+      bounceKey(keys[i], false, rnd);
+      expectedClicks[keys[i]]++;
+    }
+    run(300);
+  }
+
+  unsigned long deadline;
+  if (pinGroup.nextDeadlineMs(deadline) || portGroup.nextDeadlineMs(deadline)) ok = false;
+
+  unsigned long total = 0, expectedTotal = 0;
+  for (int k = 0; k < SIM_KEYS; k++) {
+    total += clicks[k];
+    expectedTotal += expectedClicks[k];
+    if (clicks[k] != expectedClicks[k]) ok = false;
+    if (longPresses[k]) ok = false;
+  }
+
+  printf("%d buttons in 2 groups, %d rounds, %lu interrupts, %lu ticks\n", SIM_KEYS, rounds, isrCalls, ticks);
+  printf("clicks %lu of %lu, %.2f of %d buttons advanced per tick\n",
+         total, expectedTotal, ticks ? (double)dueLanes / ticks : 0.0, SIM_KEYS);
+  printf("%s\n", ok ? "OK" : "FAILED");
+
+  pinGroup.end();
+  portGroup.end();
+  return ok ? 0 : 1;
+}  // main()
@@ -0,0 +1,201 @@
+/**
+ * @file OneButtonMatrixSim.cpp
+ *
+ * @brief Host simulation of an 8x8 button matrix scanned by the OneButtonMatrix class.
+ *
+ * The simulated matrix has no diodes: a driven row pulls down all columns that are connected
+ * to it by pressed keys, also through other rows, so 3 pressed keys at the corners of a
+ * rectangle make the 4th key read as pressed. Keys are clicked with bouncing contacts alone,
+ * together and in ghosting combinations. All clicks must be detected and no ghost key may
+ * report an event.
+ *
+ * Usage: OneButtonMatrixSim [rounds]
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ */
+
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Arduino.h"
+#include "OneButton.h"
+#include "OneButtonMatrix.h"
+
+#define SIM_ROWS 8
+#define SIM_COLS 8
+
+static uint8_t pressed[SIM_ROWS];  // the keys that are really pressed, one bit per column.
+static unsigned long rowReads = 0;
+static unsigned long clicks[SIM_ROWS][SIM_COLS];
+static unsigned long longPresses[SIM_ROWS][SIM_COLS];
+
+
+// the columns pulled down while a row is driven LOW, following the connections by pressed keys.
+static uint8_t readColumns(uint8_t row) {
+  uint8_t rows = 1 << row;
+  uint8_t cols = 0;
+  uint8_t last;
+
+  rowReads++;
+  do {
+    last = cols;
+    for (int r = 0; r < SIM_ROWS; r++) {
+      if (rows & (1 << r)) cols |= pressed[r];
+    }
+    for (int r = 0; r < SIM_ROWS; r++) {
+      if (pressed[r] & cols) rows |= (1 << r);
+    }
+  } while (cols != last);
+  return cols;
+}
+
+
+static void onClick(void *param) {
+  intptr_t key = (intptr_t)param;
+  clicks[key / SIM_COLS][key % SIM_COLS]++;
+}
+
+static void onLongPressStart(void *param) {
+  intptr_t key = (intptr_t)param;
+  longPresses[key / SIM_COLS][key % SIM_COLS]++;
+}
+
+
+static OneButtonMatrix *matrix;
+static unsigned long ticks = 0;
+
+// let the time pass by scanning every msec.
+static void run(unsigned long ms) {
+  while (ms--) {
+    ArduinoHost::advanceMillis(1);
+    matrix->tick();
+    ticks++;
+  }
+}
+
+// press or release keys with some bouncing.
+static void setKeys(int row, uint8_t cols, bool down, std::mt19937 &rnd) {
+  for (int b = rnd() % 4; b > 0; b--) {
+    pressed[row] ^= cols;
+    run(1);
+    pressed[row] ^= cols;
+    run(1);
+  }
+  if (down) {
+    pressed[row] |= cols;
+  } else {
+    pressed[row] &= ~cols;
+  }
+}
+
+
+int main(int argc, char *argv[]) {
+  int rounds = (argc > 1) ? atoi(argv[1]) : 200;
+
+  static const uint8_t rowPins[SIM_ROWS] = { 2, 3, 4, 5, 6, 7, 8, 9 };
+  static const uint8_t colPins[SIM_COLS] = { 10, 11, 12, 13, 14, 15, 16, 17 };
+  static OneButton buttons[SIM_ROWS][SIM_COLS];
+
+  ArduinoHost::reset();
+  OneButtonMatrix m(rowPins, SIM_ROWS, colPins, SIM_COLS);
+  matrix = &m;
+  m.begin();
+  m.setColumnReader(readColumns);
+  m.setDebounceMs(10);
+
+  for (intptr_t r = 0; r < SIM_ROWS; r++) {
+    for (intptr_t c = 0; c < SIM_COLS; c++) {
+      OneButton &b = buttons[r][c];
+      b.setClickMs(150);
+      b.setPressMs(400);
+      b.attachClick(onClick, (void *)(r * SIM_COLS + c));
+      b.attachLongPressStart(onLongPressStart, (void *)(r * SIM_COLS + c));
+      m.attach(r, c, &b);
+    }
+  }
+
+  std::mt19937 rnd(42);
+  unsigned long expectedClicks[SIM_ROWS][SIM_COLS] = {};
+  unsigned long ghostTests = 0;
+  bool ok = true;
+
+  run(100);
+  for (int n = 0; n < rounds; n++) {
+    int r1 = rnd() % SIM_ROWS;
+    int c1 = rnd() % SIM_COLS;
+
+    switch (n % 3) {
+      case 0:
+        // a single key.
+        setKeys(r1, 1 << c1, true, rnd);
+        run(60);
+        setKeys(r1, 1 << c1, false, rnd);
+        expectedClicks[r1][c1]++;
+        break;
+
+      case 1:
+        {
+          // 2 keys in different rows and columns together.
+          int r2 = (r1 + 1 + rnd() % (SIM_ROWS - 1)) % SIM_ROWS;
+          int c2 = (c1 + 1 + rnd() % (SIM_COLS - 1)) % SIM_COLS;
+          setKeys(r1, 1 << c1, true, rnd);
+          setKeys(r2, 1 << c2, true, rnd);
+          run(60);
+          setKeys(r1, 1 << c1, false, rnd);
+          setKeys(r2, 1 << c2, false, rnd);
+          expectedClicks[r1][c1]++;
+          expectedClicks[r2][c2]++;
+          break;
+        }
+
+      case 2:
+        {
+          // a key is clicked, then 2 more keys make 3 corners of a rectangle.
+          int r2 = (r1 + 1 + rnd() % (SIM_ROWS - 1)) % SIM_ROWS;
+          int c2 = (c1 + 1 + rnd() % (SIM_COLS - 1)) % SIM_COLS;
+          setKeys(r1, 1 << c1, true, rnd);
+          run(60);
+          setKeys(r1, 1 << c2, true, rnd);
+          setKeys(r2, 1 << c1, true, rnd);
+          run(60);
+          if (m.levels(r2) & (1 << c2)) ok = false;  // the ghost key must not be pressed.
+          if (m.isGhosting()) ghostTests++;
+          setKeys(r2, 1 << c1, false, rnd);
+          setKeys(r1, 1 << c2, false, rnd);
+          run(60);
+          setKeys(r1, 1 << c1, false, rnd);
+          // the first key is held down long enough for a click only.
+          expectedClicks[r1][c1]++;
+          break;
+        }
+    }
+    run(400);
+  }
+
+  unsigned long total = 0, expectedTotal = 0, extra = 0;
+  for (int r = 0; r < SIM_ROWS; r++) {
+    for (int c = 0; c < SIM_COLS; c++) {
+      total += clicks[r][c];
+      expectedTotal += expectedClicks[r][c];
+      if (clicks[r][c] > expectedClicks[r][c]) extra += clicks[r][c] - expectedClicks[r][c];
+      if (clicks[r][c] != expectedClicks[r][c]) ok = false;
+      if (longPresses[r][c]) ok = false;
+    }
+  }
+  if (ghostTests != (unsigned long)rounds / 3) ok = false;
+
+  printf("%dx%d matrix, %d rounds, %lu scans, %.1f row reads per scan\n",
+         SIM_ROWS, SIM_COLS, rounds, ticks, ticks ? (double)rowReads / ticks : 0.0);
+  printf("clicks %lu of %lu, unexpected %lu, ghosting detected %lu times in %lu scans\n",
+         total, expectedTotal, extra, ghostTests, m.ghostScans());
+  printf("%s\n", ok ? "OK" : "FAILED");
+  return ok ? 0 : 1;
+}  // main()
+
+
+// end.
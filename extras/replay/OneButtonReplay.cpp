@@ -0,0 +1,300 @@
+/**
+ * @file OneButtonReplay.cpp
+ *
+ * @brief Host tool replaying recorded input traces through the OneButton and OneButtonTiny state machines.
+ *
+ * The traces are created by the OneButtonTraceRecorder class and stored in binary files or as
+ * hex dumps like printed by the TraceRecorder example. A file may hold many traces one after the other.
+ * Every trace is fed into a new button using the virtual clock of the host Arduino shim so the
+ * replay runs much faster than real time. The detected events and a summary including the
+ * throughput of the state machine are printed.
+ *
+ * Usage: OneButtonReplay [options] file...
+ *   -t        use OneButtonTiny instead of OneButtonFull
+ *   -d ms     debounce msecs (default 50)
+ *   -c ms     click msecs (default 400)
+ *   -p ms     press msecs (default 800)
+ *   -i ms     msecs between 2 ticks (default 1)
+ *   -n        tickless: tick only at level changes and at the deadlines by nextDeadlineMs()
+ *   -s ms     msecs to continue after the end of a trace (default 2000)
+ *   -r n      replay every trace n times for benchmarking (default 1)
+ *   -e        print the detected events
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ */
+
+#include <chrono>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "Arduino.h"
+#include "OneButton.h"
+#include "OneButtonTiny.h"
+#include "OneButtonTrace.h"
+
+// ----- Options -----
+
+struct Options {
+  bool tiny = false;
+  int debounceMs = 50;
+  unsigned int clickMs = 400;
+  unsigned int pressMs = 800;
+  unsigned long tickMs = 1;
+  bool tickless = false;
+  unsigned long settleMs = 2000;
+  int repeat = 1;
+  bool printEvents = false;
+};
+
+static Options opt;
+
+
+// ----- Event recording -----
+
+static const char *eventNames[] = { "press", "click", "doubleclick", "multiclick", "longpressstart", "duringlongpress", "longpressstop", "idle", "tentativeclick", "clicksuperseded" };
+
+static unsigned long eventCounts[10];
+static const char *traceName;  // file and number of the replayed trace.
+static bool printing;          // print the events of the current replay.
+
+static void emit(OneButtonBase::event_t event, int clicks) {
+  eventCounts[event]++;
+  if (printing) {
+    printf("%s %8lu %s", traceName, millis(), eventNames[event]);
+    if (event == OneButtonBase::EV_MULTICLICK) printf(" %d", clicks);
+    printf("\n");
+  }
+}
+
+template<class BUTTON>
+struct Events {
+  static BUTTON *button;
+
+  static void click() {
+    emit(OneButtonBase::EV_CLICK, 1);
+  }
+  static void doubleClick() {
+    emit(OneButtonBase::EV_DOUBLECLICK, 2);
+  }
+  static void multiClick() {
+    emit(OneButtonBase::EV_MULTICLICK, button->getNumberClicks());
+  }
+  static void longPressStart() {
+    emit(OneButtonBase::EV_LONGPRESSSTART, 0);
+  }
+  static void longPressStop() {
+    emit(OneButtonBase::EV_LONGPRESSSTOP, 0);
+  }
+};
+template<class BUTTON> BUTTON *Events<BUTTON>::button = NULL;
+
+static void attachEvents(OneButtonFull &b) {
+  Events<OneButtonFull>::button = &b;
+  b.attachClick(Events<OneButtonFull>::click);
+  b.attachDoubleClick(Events<OneButtonFull>::doubleClick);
+  b.attachMultiClick(Events<OneButtonFull>::multiClick);
+  b.attachLongPressStart(Events<OneButtonFull>::longPressStart);
+  b.attachLongPressStop(Events<OneButtonFull>::longPressStop);
+}
+
+static void attachEvents(OneButtonTiny &b) {
+  Events<OneButtonTiny>::button = &b;
+  b.attachClick(Events<OneButtonTiny>::click);
+  b.attachDoubleClick(Events<OneButtonTiny>::doubleClick);
+  b.attachLongPressStart(Events<OneButtonTiny>::longPressStart);
+}
+
+
+// ----- Replay -----
+
+static unsigned long long totalTicks = 0;
+static unsigned long long totalMs = 0;
+static unsigned long totalRecords = 0;
+
+// advance the virtual clock and the button until the given time using the same level.
+template<class BUTTON>
+static void advance(BUTTON &b, bool level, unsigned long until) {
+  unsigned long t = millis();
+
+  if (opt.tickless) {
+    typedef typename BUTTON::time_type time_type;
+    time_type deadline;
+    while (b.nextDeadlineMs(deadline)) {
+      // the deadline may use less bits than the clock.
+      time_type d = deadline - (time_type)t;
+      unsigned long next = (d > ((time_type)~(time_type)0 >> 1)) ? t : t + d;
+
+      // at most one tick per msec, also when a deadline is due already.
+      if (next <= t) next = t + 1;
+      if (next >= until) break;
+      t = next;
+      ArduinoHost::setMillis(t);
+      b.tick(level);
+      totalTicks++;
+    }
+
+  } else {
+    while (t + opt.tickMs < until) {
+      t += opt.tickMs;
+      ArduinoHost::setMillis(t);
+      b.tick(level);
+      totalTicks++;
+    }
+  }
+  ArduinoHost::setMillis(until);
+}  // advance()
+
+
+template<class BUTTON>
+static void replayTrace(const uint8_t *data, size_t size) {
+  OneButtonTraceReader reader(data, size);
+  bool level, newLevel;
+  unsigned long ms;
+
+  ArduinoHost::reset();
+  BUTTON b;
+  b.setDebounceMs(opt.debounceMs);
+  b.setClickMs(opt.clickMs);
+  b.setPressMs(opt.pressMs);
+  attachEvents(b);
+
+  if (!reader.next(level, ms)) return;
+  totalRecords++;
+  b.tick(level);
+  totalTicks++;
+
+  while (reader.next(newLevel, ms)) {
+    totalRecords++;
+    advance(b, level, ms);
+    level = newLevel;
+    b.tick(level);
+    totalTicks++;
+  }
+
+  // let the pending timers expire.
+  advance(b, level, ms + opt.settleMs + 1);
+  totalMs += millis();
+}  // replayTrace()
+
+
+// ----- File input -----
+
+// read a file as binary trace or as hex dump.
+static bool readFile(const char *fileName, std::vector<uint8_t> &data) {
+  FILE *f = fopen(fileName, "rb");
+  if (!f) return false;
+
+  std::vector<uint8_t> raw;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) raw.insert(raw.end(), buf, buf + n);
+  fclose(f);
+
+  data.clear();
+  if ((raw.size() >= 2) && (raw[0] == 'O') && (raw[1] == 'B')) {
+    data = raw;
+
+  } else {
+    // hex dump, all characters that are not hex digits separate the bytes.
+    int nibbles = 0;
+    uint8_t v = 0;
+    for (uint8_t c : raw) {
+      if (isxdigit(c)) {
+        v = (v << 4) | (isdigit(c) ? c - '0' : tolower(c) - 'a' + 10);
+        if (++nibbles == 2) {
+          data.push_back(v);
+          nibbles = v = 0;
+        }
+      } else {
+        nibbles = v = 0;
+      }
+    }
+  }
+  return true;
+}  // readFile()
+
+
+static void usage() {
+  fprintf(stderr, "Usage: OneButtonReplay [-t] [-d ms] [-c ms] [-p ms] [-i ms] [-n] [-s ms] [-r n] [-e] file...\n");
+}
+
+
+int main(int argc, char *argv[]) {
+  int c;
+  while ((c = getopt(argc, argv, "td:c:p:i:ns:r:e")) != -1) {
+    switch (c) {
+      case 't': opt.tiny = true; break;
+      case 'd': opt.debounceMs = atoi(optarg); break;
+      case 'c': opt.clickMs = atoi(optarg); break;
+      case 'p': opt.pressMs = atoi(optarg); break;
+      case 'i': opt.tickMs = max(1, atoi(optarg)); break;
+      case 'n': opt.tickless = true; break;
+      case 's': opt.settleMs = atoi(optarg); break;
+      case 'r': opt.repeat = max(1, atoi(optarg)); break;
+      case 'e': opt.printEvents = true; break;
+      default: usage(); return 2;
+    }
+  }
+  if (optind >= argc) {
+    usage();
+    return 2;
+  }
+
+  unsigned long traces = 0;
+  double ns = 0;
+  char name[256];
+  std::vector<uint8_t> data;
+
+  for (int a = optind; a < argc; a++) {
+    if (!readFile(argv[a], data)) {
+      fprintf(stderr, "%s: cannot read file\n", argv[a]);
+      return 1;
+    }
+
+    size_t pos = 0;
+    for (int nr = 0; pos < data.size(); nr++) {
+      OneButtonTraceReader reader(data.data() + pos, data.size() - pos);
+      if (!reader.valid()) {
+        fprintf(stderr, "%s: invalid trace at offset %zu\n", argv[a], pos);
+        break;
+      }
+      snprintf(name, sizeof(name), "%s#%d", argv[a], nr);
+      traceName = name;
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      for (int r = 0; r < opt.repeat; r++) {
+        printing = opt.printEvents && (r == 0);
+        if (opt.tiny) {
+          replayTrace<OneButtonTiny>(data.data() + pos, reader.size());
+        } else {
+          replayTrace<OneButtonFull>(data.data() + pos, reader.size());
+        }
+      }
+      ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+      traces++;
+      pos += reader.size();
+    }
+  }
+
+  printf("%s: %lu traces, %d replays each, %lu level changes, %llu ticks, %.1f s replayed\n",
+         opt.tiny ? "OneButtonTiny" : "OneButtonFull", traces, opt.repeat, totalRecords, totalTicks, totalMs / 1000.0);
+  printf("events:");
+  for (int e = 0; e < 10; e++) {
+    if (eventCounts[e]) printf(" %s=%lu", eventNames[e], eventCounts[e]);
+  }
+  printf("\n");
+  printf("%.1f ms wall time, %.2f ns/tick, %.0fx real time\n",
+         ns / 1e6, totalTicks ? ns / totalTicks : 0.0, ns ? totalMs * 1e6 / ns : 0.0);
+  return 0;
+}  // main()
+
+
+// end.
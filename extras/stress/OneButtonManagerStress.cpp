@@ -0,0 +1,131 @@
+/**
+ * @file OneButtonManagerStress.cpp
+ *
+ * @brief Host stress test for the OneButtonManager using real threads and slow event functions.
+ *
+ * Many buttons are clicked in a random pattern by the main thread while the manager scans them
+ * in its own thread. Some event functions take much longer than the scan interval. All clicks
+ * must be detected, no event may be dropped and the scanning must keep its cadence.
+ *
+ * Usage: OneButtonManagerStress [rounds] [slow msecs]
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ */
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "Arduino.h"
+#include "OneButton.h"
+#include "OneButtonManager.h"
+
+#define STRESS_BUTTONS 16
+#define SCAN_MS 5
+
+static std::atomic<int> pinLevel[STRESS_BUTTONS];
+static std::atomic<unsigned long> clicks[STRESS_BUTTONS];
+static std::atomic<unsigned long> longPresses;
+static int slowMs = 100;
+
+// the simulated input levels, button n uses pin n.
+static int readPin(uint8_t pin) {
+  return (pin < STRESS_BUTTONS) ? pinLevel[pin].load() : HIGH;
+}
+
+static void onClick(void *param) {
+  clicks[(intptr_t)param]++;
+}
+
+// a slow event function blocking the worker thread.
+static void onLongPressStart() {
+  longPresses++;
+  std::this_thread::sleep_for(std::chrono::milliseconds(slowMs));
+}
+
+static void sleepMs(int ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+
+int main(int argc, char *argv[]) {
+  int rounds = (argc > 1) ? atoi(argv[1]) : 20;
+  if (argc > 2) slowMs = atoi(argv[2]);
+
+  ArduinoHost::reset();
+  ArduinoHost::setDigitalReadFunction(readPin);
+  ArduinoHost::setRealTime(true);
+
+  static OneButtonFull buttons[STRESS_BUTTONS];
+  static OneButtonEvent eventBuffer[64];
+  OneButtonManager manager(eventBuffer, 64);
+  manager.setScanMs(SCAN_MS);
+
+  for (intptr_t n = 0; n < STRESS_BUTTONS; n++) {
+    pinLevel[n] = HIGH;
+    buttons[n].setup(n);
+    buttons[n].setDebounceMs(10);
+    buttons[n].setClickMs(150);
+    buttons[n].setPressMs(300);
+    buttons[n].attachClick(onClick, (void *)n);
+    if (n == 0) buttons[n].attachLongPressStart(onLongPressStart);
+    manager.add(&buttons[n]);
+  }
+
+  std::mt19937 rnd(42);
+  unsigned long expectedClicks[STRESS_BUTTONS] = { 0 };
+  unsigned long expectedLongPresses = 0;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  manager.begin();
+
+  for (int r = 0; r < rounds; r++) {
+    // a random subset of the buttons is clicked once.
+    uint32_t mask = rnd() & ((1 << STRESS_BUTTONS) - 1);
+    for (int n = 1; n < STRESS_BUTTONS; n++) {
+      if (mask & (1 << n)) {
+        pinLevel[n] = LOW;
+        expectedClicks[n]++;
+      }
+    }
+    // button 0 is held down to start the slow function.
+    pinLevel[0] = LOW;
+    expectedLongPresses++;
+
+    sleepMs(60);
+    for (int n = 1; n < STRESS_BUTTONS; n++) pinLevel[n] = HIGH;
+    sleepMs(300);
+    pinLevel[0] = HIGH;
+    sleepMs(200);
+  }
+  sleepMs(slowMs + 50);
+  manager.end();
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  unsigned long expectedScans = (unsigned long)(seconds * 1000 / SCAN_MS);
+
+  bool ok = (manager.dropped() == 0) && (longPresses == expectedLongPresses);
+  unsigned long total = 0, expectedTotal = 0;
+  for (int n = 0; n < STRESS_BUTTONS; n++) {
+    total += clicks[n];
+    expectedTotal += expectedClicks[n];
+    if (clicks[n] != expectedClicks[n]) ok = false;
+  }
+
+  printf("%d buttons, %d rounds, %.2f s, slow function %d msecs\n", STRESS_BUTTONS, rounds, seconds, slowMs);
+  printf("clicks %lu of %lu, long presses %lu of %lu, dropped %u\n",
+         total, expectedTotal, longPresses.load(), expectedLongPresses, manager.dropped());
+  printf("scans %lu of %lu, overruns %lu\n", manager.scans(), expectedScans, manager.overruns());
+  printf("%s\n", ok ? "OK" : "FAILED");
+  return ok ? 0 : 1;
+}  // main()
+
+
+// end.
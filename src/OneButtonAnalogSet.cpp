@@ -0,0 +1,200 @@
+/**
+ * @file OneButtonAnalogSet.cpp
+ *
+ * @brief Library for detecting button clicks, doubleclicks and long press
+ * pattern on several buttons connected to one analog input by a resistor ladder.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonAnalogSet.h
+ */
+
+#include "OneButtonAnalogSet.h"
+
+// ----- Initialization and Default Values -----
+
+OneButtonAnalogSet::OneButtonAnalogSet() {
+  for (int n = 0; n < ONEBUTTONANALOG_BUTTONS; n++) _buttons[n] = NULL;
+  _addEntry(1023, 0);
+}  // OneButtonAnalogSet
+
+
+OneButtonAnalogSet::OneButtonAnalogSet(const int pin)
+  : OneButtonAnalogSet() {
+  _pin = pin;
+}  // OneButtonAnalogSet
+
+
+// add a button with the value measured while only this button is pressed.
+bool OneButtonAnalogSet::addButton(OneButton *button, const int value) {
+  if ((button == NULL) || (_count >= ONEBUTTONANALOG_BUTTONS)) return false;
+  if (!_addEntry(value, (uint8_t)(1 << _count))) return false;
+
+  _buttons[_count++] = button;
+  return true;
+}  // addButton()
+
+
+// add the value measured while several buttons are pressed together.
+bool OneButtonAnalogSet::addCombination(const int value, const uint8_t mask) {
+  if (mask == 0) return false;
+  return _addEntry(value, mask);
+}  // addCombination()
+
+
+// set the value measured while no button is pressed.
+void OneButtonAnalogSet::setIdleValue(const int value) {
+  _addEntry(value, 0);
+}  // setIdleValue()
+
+
+bool OneButtonAnalogSet::_addEntry(const int value, const uint8_t mask) {
+  uint8_t n;
+
+  // remove an entry with the same mask.
+  for (n = 0; n < _entryCount; n++) {
+    if (_entries[n].mask == mask) {
+      _entryCount--;
+      for (; n < _entryCount; n++) _entries[n] = _entries[n + 1];
+      break;
+    }
+  }
+  if (_entryCount >= ONEBUTTONANALOG_ENTRIES) return false;
+
+  // insert sorted by value.
+  n = _entryCount++;
+  while ((n > 0) && (_entries[n - 1].value > value)) {
+    _entries[n] = _entries[n - 1];
+    n--;
+  }
+  _entries[n].value = value;
+  _entries[n].mask = mask;
+
+  // start decoding at the entry of the decoded set.
+  _current = 0;
+  for (n = 0; n < _entryCount; n++) {
+    if (_entries[n].mask == _lastMask) _current = n;
+  }
+  return true;
+}  // _addEntry()
+
+
+void OneButtonAnalogSet::reset(void) {
+  _levels = _lastMask = 0;
+  _lastTime = millis();
+  _pending = 0;
+
+  for (uint8_t n = 0; n < _entryCount; n++) {
+    if (_entries[n].mask == 0) _current = n;
+  }
+
+  for (uint8_t n = 0; n < _count; n++) {
+    OneButton *b = _buttons[n];
+    b->reset();
+    if (b->isPending()) _pending |= (1 << n);
+  }
+}  // reset()
+
+
+/**
+ * @brief Find the table entry for a sample.
+ * The current entry is kept while the sample is within the range up to the middle
+ * to the neighbor entries extended by the hysteresis, otherwise the nearest entry is taken.
+ */
+uint8_t OneButtonAnalogSet::_decode(const int value) const {
+  uint8_t c = _current;
+
+  if (((c == 0) || (value > (_entries[c - 1].value + _entries[c].value) / 2 - _hysteresis))
+      && ((c + 1 >= _entryCount) || (value < (_entries[c].value + _entries[c + 1].value) / 2 + _hysteresis))) {
+    return c;
+  }
+
+  // binary search for the first entry with a value not less than the sample.
+  uint8_t lo = 0, hi = _entryCount;
+  while (lo < hi) {
+    uint8_t mid = (lo + hi) / 2;
+    if (_entries[mid].value < value) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  if (lo == _entryCount) return lo - 1;
+  if ((lo > 0) && (value - _entries[lo - 1].value < _entries[lo].value - value)) return lo - 1;
+  return lo;
+}  // _decode()
+
+
+// get the earliest deadline of debouncing and all pending buttons.
+bool OneButtonAnalogSet::nextDeadlineMs(unsigned long &deadline) const {
+  bool found = false;
+  unsigned long ms;
+
+  // a new set of pressed buttons is waiting to be stable.
+  if (_lastMask != _levels) {
+    deadline = _lastTime + _debounce_ms;
+    found = true;
+  }
+
+  uint8_t buttons = _pending;
+  while (buttons) {
+    uint8_t n = __builtin_ctz(buttons);
+    buttons &= ~(1 << n);
+
+    if (_buttons[n]->nextDeadlineMs(ms) && (!found || ((long)(ms - deadline) < 0))) {
+      deadline = ms;
+      found = true;
+    }
+  }
+  return found;
+}  // nextDeadlineMs()
+
+
+/**
+ * @brief Decode the sample, debounce the set of pressed buttons and then
+ * advance the finite state machines (FSM) of the changed or pending buttons only.
+ */
+void OneButtonAnalogSet::tick(const int value) {
+  unsigned long now = millis();  // one time for all buttons.
+  uint8_t changed = 0;
+
+  if (_entryCount == 0) return;
+  _current = _decode(value);
+
+  // values passed while the voltage is moving are not stable for the debounce time.
+  uint8_t mask = _entries[_current].mask;
+  if (mask != _lastMask) {
+    _lastMask = mask;
+    _lastTime = now;
+  }
+  if ((_lastMask != _levels) && (now - _lastTime >= _debounce_ms)) {
+    changed = _lastMask ^ _levels;
+    _levels = _lastMask;
+  }
+
+  uint8_t buttons = changed | _pending;
+  while (buttons) {
+    uint8_t n = __builtin_ctz(buttons);
+    uint8_t bit = 1 << n;
+    buttons &= ~bit;
+
+    OneButton *b = _buttons[n];
+    if (b == NULL) continue;  // a combination with a mask beyond the buttons.
+    b->tickDebounced(_levels & bit, now);
+    if (b->isPending()) {
+      _pending |= bit;
+    } else {
+      _pending &= ~bit;
+    }
+  }
+}  // tick()
+
+
+// end.
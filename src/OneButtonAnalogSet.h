@@ -0,0 +1,166 @@
+// -----
+// OneButtonAnalogSet.h - Library for detecting button clicks, doubleclicks and
+// long press pattern on several buttons connected to one analog input by a
+// resistor ladder.
+// This class is implemented for use with the Arduino environment.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// Every scan takes one analog sample that is decoded into the set of pressed
+// buttons by using a table of the nominal values sorted by value. The nearest
+// entry is found by a binary search and the current entry is kept while the
+// sample stays within its range extended by the hysteresis.
+// Entries for combinations of pressed buttons can be added to resolve
+// multi-press values, otherwise the nearest single button is taken.
+// The decoded set is debounced once and only the buttons with a changed
+// level or with pending timers advance their finite state machine.
+// -----
+
+#ifndef OneButtonAnalogSet_h
+#define OneButtonAnalogSet_h
+
+#include "Arduino.h"
+#include "OneButton.h"
+
+#define ONEBUTTONANALOG_BUTTONS 8
+
+// The maximum number of table entries for the idle value, the buttons and their combinations.
+#ifndef ONEBUTTONANALOG_ENTRIES
+#define ONEBUTTONANALOG_ENTRIES 16
+#endif
+
+
+class OneButtonAnalogSet {
+public:
+  // ----- Constructor -----
+
+  /**
+   * Create a OneButtonAnalogSet instance without any buttons.
+   * Use tick(value) to pass the samples.
+   */
+  OneButtonAnalogSet();
+
+  /**
+   * Create a OneButtonAnalogSet instance reading the given analog pin in tick().
+   * @param pin The analog input pin.
+   */
+  explicit OneButtonAnalogSet(const int pin);
+
+  // ----- Set runtime parameters -----
+
+  /**
+   * Add a button with the analog value that is measured while only this button is pressed.
+   * The button should be created without a pin as the level is given by the set.
+   * @param button The button.
+   * @param value The nominal analog value.
+   * @return false when the set or the table is full.
+   */
+  bool addButton(OneButton *button, const int value);
+
+  /**
+   * Add the analog value that is measured while several buttons are pressed together.
+   * @param value The nominal analog value.
+   * @param mask The buttons in the order they were added, bit 0 is the first button.
+   * @return false when the table is full.
+   */
+  bool addCombination(const int value, const uint8_t mask);
+
+  /**
+   * Set the analog value that is measured while no button is pressed. Default is 1023.
+   */
+  void setIdleValue(const int value);
+
+  /**
+   * Set the distance a sample must move beyond the middle between 2 entries
+   * before a different entry is taken. Default is 8.
+   */
+  void setHysteresis(const int value) {
+    _hysteresis = value;
+  };
+
+  /**
+   * set # millisec a decoded set of pressed buttons must be stable to be taken over.
+   */
+  void setDebounceMs(const unsigned int ms) {
+    _debounce_ms = ms;
+  };
+
+  // ----- State machine functions -----
+
+  /**
+   * @brief Call this function every some milliseconds for reading the analog pin.
+   */
+  void tick(void) {
+    if (_pin >= 0) tick(analogRead(_pin));
+  };
+
+  /**
+   * @brief Call this function every some milliseconds with an analog sample.
+   * @param value The analog value.
+   */
+  void tick(const int value);
+
+  /**
+   * Reset the debouncing and the state machines of all buttons.
+   */
+  void reset(void);
+
+  /**
+   * @return The debounced set of pressed buttons, bit 0 is the first button.
+   */
+  uint8_t pressedMask() const {
+    return _levels;
+  };
+
+  /**
+   * @return The set of pressed buttons decoded from the last sample.
+   */
+  uint8_t decodedMask() const {
+    return _entries[_current].mask;
+  };
+
+  /**
+   * @brief Get the earliest time when tick() must be called next to finish debouncing
+   * or to advance the FSM of a button with pending timers.
+   * @param deadline Set to the time in msecs as returned by millis().
+   * @return false when no timer is pending and only a new sample can advance the FSMs.
+   */
+  bool nextDeadlineMs(unsigned long &deadline) const;
+
+private:
+  int _pin = -1;  // analog input pin.
+
+  OneButton *_buttons[ONEBUTTONANALOG_BUTTONS];
+  uint8_t _count = 0;  // number of buttons.
+
+  // the decoding table sorted by value.
+  struct entry_t {
+    int value;
+    uint8_t mask;
+  };
+  entry_t _entries[ONEBUTTONANALOG_ENTRIES];
+  uint8_t _entryCount = 0;
+  uint8_t _current = 0;  // index of the current entry.
+
+  int _hysteresis = 8;
+  unsigned int _debounce_ms = 20;  // number of msecs for debounce times.
+
+  uint8_t _levels = 0;          // debounced set of pressed buttons.
+  uint8_t _lastMask = 0;        // last decoded set used for debouncing.
+  unsigned long _lastTime = 0;  // millis() of the last change of the decoded set.
+  uint8_t _pending = 0;         // buttons with pending timers in the FSM.
+
+  /**
+   * Add an entry to the sorted table replacing an entry with the same mask.
+   */
+  bool _addEntry(const int value, const uint8_t mask);
+
+  /**
+   * Find the entry for a sample.
+   */
+  uint8_t _decode(const int value) const;
+};
+
+#endif
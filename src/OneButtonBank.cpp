@@ -0,0 +1,146 @@
+/**
+ * @file OneButtonBank.cpp
+ *
+ * @brief Library for detecting button clicks, doubleclicks and long press
+ * pattern on up to 32 buttons that are read together from one input port.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonBank.h
+ */
+
+#include "OneButtonBank.h"
+
+// ----- Initialization and Default Values -----
+
+OneButtonBank::OneButtonBank() {
+  for (int n = 0; n < ONEBUTTONBANK_LANES; n++) _buttons[n] = NULL;
+}  // OneButtonBank
+
+
+// attach or detach a button for a lane.
+void OneButtonBank::attach(const uint8_t lane, OneButton *button) {
+  if (lane >= ONEBUTTONBANK_LANES) return;
+
+  uint32_t bit = (uint32_t)1 << lane;
+  _buttons[lane] = button;
+  _pending &= ~bit;
+
+  if (button) {
+    _attached |= bit;
+    if (button->isPending()) _pending |= bit;
+  } else {
+    _attached &= ~bit;
+  }
+}  // attach
+
+
+// set the number of equal samples required for a new level.
+void OneButtonBank::setDebounceSamples(const uint8_t samples) {
+  _samples = constrain(samples, 1, 8);
+}  // setDebounceSamples
+
+
+void OneButtonBank::reset(void) {
+  _levels = 0;
+  _cnt0 = _cnt1 = _cnt2 = 0;
+  _pending = 0;
+
+  for (uint8_t lane = 0; lane < ONEBUTTONBANK_LANES; lane++) {
+    OneButton *b = _buttons[lane];
+    if (b) {
+      b->reset();
+      if (b->isPending()) _pending |= ((uint32_t)1 << lane);
+    }
+  }
+}  // reset()
+
+
+/**
+ * @brief Debounce all lanes by using vertical counters.
+ * The counter of a lane counts the samples in a row that differ from the debounced level
+ * and is cleared by any sample equal to the debounced level.
+ */
+uint32_t OneButtonBank::_debounce(const uint32_t levels) {
+  uint32_t delta = levels ^ _levels;  // lanes that differ from the debounced level.
+
+  // lanes with a counter value of (_samples - 1) take over the new level with this sample.
+  uint8_t last = _samples - 1;
+  uint32_t match = ~(_cnt0 ^ (0 - (uint32_t)(last & 1)))
+                   & ~(_cnt1 ^ (0 - (uint32_t)((last >> 1) & 1)))
+                   & ~(_cnt2 ^ (0 - (uint32_t)((last >> 2) & 1)));
+  uint32_t toggle = delta & match;
+  uint32_t count = delta & ~match;
+
+  // increment the counters of the counting lanes, clear all others.
+  _cnt2 = (_cnt2 ^ (_cnt1 & _cnt0)) & count;
+  _cnt1 = (_cnt1 ^ _cnt0) & count;
+  _cnt0 = ~_cnt0 & count;
+
+  _levels ^= toggle;
+  return toggle;
+}  // _debounce()
+
+
+// get the earliest deadline of debouncing and all pending buttons.
+bool OneButtonBank::nextDeadlineMs(unsigned long &deadline) const {
+  bool found = false;
+  unsigned long ms;
+
+  // some lanes are counting equal samples.
+  if (_cnt0 | _cnt1 | _cnt2) {
+    deadline = _lastSampleTime + _sample_ms;
+    found = true;
+  }
+
+  uint32_t lanes = _pending & _attached;
+  while (lanes) {
+    uint8_t lane = __builtin_ctzl(lanes);
+    lanes &= ~((uint32_t)1 << lane);
+
+    if (_buttons[lane]->nextDeadlineMs(ms) && (!found || ((long)(ms - deadline) < 0))) {
+      deadline = ms;
+      found = true;
+    }
+  }
+  return found;
+}  // nextDeadlineMs()
+
+
+/**
+ * @brief Sample the input word, debounce all lanes and then
+ * advance the finite state machines (FSM) of the changed or pending buttons only.
+ */
+void OneButtonBank::tick(const uint32_t inputs) {
+  unsigned long now = millis();  // one time for all buttons.
+  uint32_t changed = 0;
+
+  if (now - _lastSampleTime >= _sample_ms) {
+    _lastSampleTime = now;
+    changed = _debounce(inputs ^ _activeLowMask);
+  }
+
+  uint32_t lanes = (changed | _pending) & _attached;
+  while (lanes) {
+    uint8_t lane = __builtin_ctzl(lanes);
+    uint32_t bit = (uint32_t)1 << lane;
+    lanes &= ~bit;
+
+    OneButton *b = _buttons[lane];
+    b->tickDebounced(_levels & bit, now);
+    if (b->isPending()) {
+      _pending |= bit;
+    } else {
+      _pending &= ~bit;
+    }
+  }
+}  // tick()
+
+
+// end.
@@ -0,0 +1,127 @@
+// -----
+// OneButtonBank.h - Library for detecting button clicks, doubleclicks and long
+// press pattern on up to 32 buttons that are read together from one input port.
+// This class is implemented for use with the Arduino environment.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// All 32 input lanes are debounced in parallel by using a vertical counter:
+// every lane has a 3 bit counter where the bits of all lanes are stored in
+// the 3 words _cnt0, _cnt1 and _cnt2. A new level is taken over when it was
+// sampled the configured number of times in a row.
+// Only the buttons with a changed debounced level or with pending timers
+// advance their finite state machine.
+// -----
+
+#ifndef OneButtonBank_h
+#define OneButtonBank_h
+
+#include "Arduino.h"
+#include "OneButton.h"
+
+#define ONEBUTTONBANK_LANES 32
+
+
+class OneButtonBank {
+public:
+  // ----- Constructor -----
+
+  /**
+   * Create a OneButtonBank instance without any buttons attached.
+   */
+  OneButtonBank();
+
+  // ----- Set runtime parameters -----
+
+  /**
+   * Attach a OneButton instance to a lane (bit) of the input word.
+   * The button should be created without a pin as the level is given by the bank.
+   * @param lane The bit number 0...31 in the input word.
+   * @param button The button to be used for this lane or NULL to detach a button.
+   */
+  void attach(const uint8_t lane, OneButton *button);
+
+  /**
+   * Set the lanes that are active LOW in the input word.
+   * Default is 0: all bits are active levels like a user-provided level bitmask.
+   */
+  void setActiveLowMask(const uint32_t mask) {
+    _activeLowMask = mask;
+  };
+
+  /**
+   * set # millisec between 2 samples of the input word used for debouncing.
+   */
+  void setSampleMs(const unsigned int ms) {
+    _sample_ms = ms;
+  };
+
+  /**
+   * set # of equal samples (1...8) in a row required for a new level.
+   * The debounce time is the number of samples multiplied by the sample msecs.
+   */
+  void setDebounceSamples(const uint8_t samples);
+
+  // ----- State machine functions -----
+
+  /**
+   * @brief Call this function every some milliseconds with the current input
+   * word, e.g. a whole 32-bit GPIO port register.
+   * @param inputs The input levels of all lanes.
+   */
+  void tick(const uint32_t inputs);
+
+  /**
+   * Reset the debouncing and the state machines of all attached buttons.
+   */
+  void reset(void);
+
+  /**
+   * @return The debounced active levels of all lanes.
+   */
+  uint32_t debouncedLevels() const {
+    return _levels;
+  };
+
+  /**
+   * @return The lanes with buttons that need ticks without a level change.
+   */
+  uint32_t pendingLanes() const {
+    return _pending;
+  };
+
+  /**
+   * @brief Get the earliest time when tick() must be called next to finish debouncing
+   * or to advance the FSM of a button with pending timers.
+   * @param deadline Set to the time in msecs as returned by millis().
+   * @return false when no timer is pending and only a level change can advance the FSMs.
+   */
+  bool nextDeadlineMs(unsigned long &deadline) const;
+
+private:
+  OneButton *_buttons[ONEBUTTONBANK_LANES];
+
+  uint32_t _attached = 0;       // lanes with attached buttons.
+  uint32_t _activeLowMask = 0;  // lanes with active LOW inputs.
+
+  unsigned int _sample_ms = 10;  // number of msecs between 2 samples.
+  uint8_t _samples = 5;          // number of equal samples required for a new level.
+
+  uint32_t _levels = 0;   // debounced active levels.
+  uint32_t _cnt0 = 0;     // vertical counter bit 0 of all lanes.
+  uint32_t _cnt1 = 0;     // vertical counter bit 1 of all lanes.
+  uint32_t _cnt2 = 0;     // vertical counter bit 2 of all lanes.
+  uint32_t _pending = 0;  // lanes with pending timers in the FSM.
+
+  unsigned long _lastSampleTime = 0;  // millis()
+
+  /**
+   * Run the vertical counters with a new sample.
+   * @return The lanes with a changed debounced level.
+   */
+  uint32_t _debounce(const uint32_t levels);
+};
+
+#endif
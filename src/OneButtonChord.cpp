@@ -0,0 +1,258 @@
+/**
+ * @file OneButtonChord.cpp
+ *
+ * @brief Library for detecting chords: combinations of buttons pressed together,
+ * over a group of OneButton instances.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonChord.h
+ */
+
+#include "OneButtonChord.h"
+
+// ----- Initialization and Default Values -----
+
+OneButtonChord::OneButtonChord() {
+  for (int n = 0; n < ONEBUTTONCHORD_BUTTONS; n++) {
+    _buttons[n] = NULL;
+    _rawTime[n] = _pressTime[n] = 0;
+  }
+}  // OneButtonChord
+
+
+// add a button to the group.
+bool OneButtonChord::addButton(OneButton *button) {
+  if ((button == NULL) || (_count >= ONEBUTTONCHORD_BUTTONS)) return false;
+
+  if (button->isPending()) _pending |= (1 << _count);
+  _buttons[_count++] = button;
+  return true;
+}  // addButton()
+
+
+bool OneButtonChord::addChord(const uint8_t mask, callbackFunction newFunction) {
+  return _addPattern(mask, newFunction, NULL, NULL);
+}  // addChord()
+
+
+bool OneButtonChord::addChord(const uint8_t mask, parameterizedCallbackFunction newFunction, void *parameter) {
+  return _addPattern(mask, NULL, newFunction, parameter);
+}  // addChord()
+
+
+bool OneButtonChord::_addPattern(const uint8_t mask, callbackFunction func, parameterizedCallbackFunction paramFunc, void *param) {
+  // a chord needs 2 or more buttons.
+  if ((mask & (mask - 1)) == 0) return false;
+
+  int n = _find(mask);
+  if (n < 0) {
+    if (_patternCount >= ONEBUTTONCHORD_PATTERNS) return false;
+
+    // insert sorted by mask.
+    n = _patternCount++;
+    while ((n > 0) && (_patterns[n - 1].mask > mask)) {
+      _patterns[n] = _patterns[n - 1];
+      n--;
+    }
+    _patterns[n].mask = mask;
+  }
+  _patterns[n].func = func;
+  _patterns[n].paramFunc = paramFunc;
+  _patterns[n].param = param;
+  return true;
+}  // _addPattern()
+
+
+// binary search for the pattern with the mask.
+int OneButtonChord::_find(const uint8_t mask) const {
+  int lo = 0, hi = _patternCount - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    if (_patterns[mid].mask == mask) return mid;
+    if (_patterns[mid].mask < mask) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return -1;
+}  // _find()
+
+
+bool OneButtonChord::_canGrow(const uint8_t mask) const {
+  // patterns with more buttons have a greater mask.
+  for (int n = _patternCount - 1; (n >= 0) && (_patterns[n].mask > mask); n--) {
+    if ((mask & ~_patterns[n].mask) == 0) return true;
+  }
+  return false;
+}  // _canGrow()
+
+
+void OneButtonChord::reset(void) {
+  _state = CHORD_IDLE;
+  _raw = _levels = _held = _pending = _chord = 0;
+
+  for (uint8_t n = 0; n < _count; n++) {
+    OneButton *b = _buttons[n];
+    b->reset();
+    if (b->isPending()) _pending |= (1 << n);
+  }
+}  // reset()
+
+
+// pass the held back presses with their time.
+void OneButtonChord::_flush(void) {
+  while (_held) {
+    uint8_t n = __builtin_ctz(_held);
+    _held &= ~(1 << n);
+
+    OneButton *b = _buttons[n];
+    b->tickDebounced(true, _pressTime[n]);
+    if (b->isPending()) _pending |= (1 << n);
+  }
+}  // _flush()
+
+
+// get the earliest deadline of the chord detection and all buttons.
+bool OneButtonChord::nextDeadlineMs(unsigned long &deadline) const {
+  bool found = false;
+  unsigned long ms;
+
+  if (_state == CHORD_COLLECT) {
+    deadline = (_find(_levels) >= 0) ? _matchTime + _hold_ms : _startTime + _chord_ms;
+    found = true;
+  }
+
+  for (uint8_t n = 0; n < _count; n++) {
+    uint8_t bit = 1 << n;
+    bool due = false;
+
+    if ((_raw ^ _levels) & bit) {
+      // the level is waiting to be stable.
+      ms = _rawTime[n] + _debounce_ms;
+      due = true;
+    } else if ((_pending & ~_held & bit) && _buttons[n]->nextDeadlineMs(ms)) {
+      due = true;
+    }
+    if (due && (!found || ((long)(ms - deadline) < 0))) {
+      deadline = ms;
+      found = true;
+    }
+  }
+  return found;
+}  // nextDeadlineMs()
+
+
+void OneButtonChord::tick(void) {
+  uint8_t levels = 0;
+
+  for (uint8_t n = 0; n < _count; n++) {
+    if (_buttons[n]->isPinActive()) levels |= (1 << n);
+  }
+  tick(levels);
+}  // tick()
+
+
+// debounce every button by time.
+void OneButtonChord::tick(const uint8_t levels) {
+  unsigned long now = millis();  // one time for all buttons.
+  uint8_t debounced = _levels;
+  uint8_t changed = levels ^ _raw;
+
+  for (uint8_t n = 0; n < _count; n++) {
+    uint8_t bit = 1 << n;
+    if (changed & bit) {
+      _rawTime[n] = now;
+    } else if (((_raw ^ _levels) & bit) && (now - _rawTime[n] >= _debounce_ms)) {
+      debounced ^= bit;
+    }
+  }
+  _raw = levels;
+  if (_debounce_ms == 0) debounced = levels;
+  _process(debounced, now);
+}  // tick()
+
+
+/**
+ * @brief Run the chord detection and then advance the finite state machines (FSM)
+ * of the changed or pending buttons that are not held back.
+ */
+void OneButtonChord::_process(const uint8_t levels, const unsigned long now) {
+  uint8_t changed = levels ^ _levels;
+  uint8_t pressed = changed & levels;
+
+  for (uint8_t n = 0; n < _count; n++) {
+    if (pressed & (1 << n)) _pressTime[n] = now;
+  }
+
+  if ((_state == CHORD_IDLE) && pressed) {
+    _state = CHORD_COLLECT;
+    _startTime = _matchTime = now;
+  }
+
+  if ((_state == CHORD_COLLECT) || (_state == CHORD_ACTIVE)) {
+    _held |= pressed;
+  }
+
+  if (_state == CHORD_COLLECT) {
+    if ((changed & ~levels) || (pressed && (now - _startTime > _chord_ms))) {
+      // a button was released or pressed too late.
+      _flush();
+      _state = CHORD_PASS;
+
+    } else {
+      if (changed) _matchTime = now;
+      int n = _find(levels);
+
+      if (n >= 0) {
+        if (now - _matchTime >= _hold_ms) {
+          _state = CHORD_ACTIVE;
+          _chord = levels;
+          if (_patterns[n].paramFunc) {
+            _patterns[n].paramFunc(_patterns[n].param);
+          } else if (_patterns[n].func) {
+            _patterns[n].func();
+          }
+        }
+
+      } else if (!_canGrow(levels) || (now - _startTime >= _chord_ms)) {
+        _flush();
+        _state = CHORD_PASS;
+      }
+    }
+  }
+
+  uint8_t buttons = (changed | _pending) & ~_held;
+  while (buttons) {
+    uint8_t n = __builtin_ctz(buttons);
+    uint8_t bit = 1 << n;
+    buttons &= ~bit;
+
+    OneButton *b = _buttons[n];
+    b->tickDebounced(levels & bit, now);
+    if (b->isPending()) {
+      _pending |= bit;
+    } else {
+      _pending &= ~bit;
+    }
+  }
+
+  // the released buttons of a chord are free again.
+  if (_state == CHORD_ACTIVE) _held &= levels;
+
+  if ((_state != CHORD_COLLECT) && (levels == 0)) {
+    _state = CHORD_IDLE;
+    _chord = 0;
+  }
+  _levels = levels;
+}  // _process()
+
+
+// end.
@@ -0,0 +1,189 @@
+// -----
+// OneButtonChord.h - Library for detecting chords: combinations of buttons
+// pressed together, over a group of OneButton instances.
+// This class is implemented for use with the Arduino environment.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// The chord object reads and debounces the buttons of the group and advances
+// their state machines by tickDebounced(). The pressed buttons are a bitmask
+// that is compared with the patterns of a table sorted by mask. While the
+// pressed buttons can still become a chord their presses are held back from
+// the state machines.
+// When all buttons of a pattern are pressed within the chord time and held
+// for the hold time the chord function is called and the presses are dropped,
+// so the buttons report no click or long press. Otherwise the held back
+// presses are passed on with the time they happened.
+// -----
+
+#ifndef OneButtonChord_h
+#define OneButtonChord_h
+
+#include "Arduino.h"
+#include "OneButton.h"
+
+// The buttons of a group are stored as bits in one byte.
+#define ONEBUTTONCHORD_BUTTONS 8
+
+// The maximum number of chord patterns.
+#ifndef ONEBUTTONCHORD_PATTERNS
+#define ONEBUTTONCHORD_PATTERNS 8
+#endif
+
+
+class OneButtonChord {
+public:
+  // ----- Constructor -----
+
+  /**
+   * Create a OneButtonChord instance without any buttons.
+   */
+  OneButtonChord();
+
+  // ----- Set runtime parameters -----
+
+  /**
+   * Add a button to the group. The button is read and ticked by the chord object only.
+   * @param button The button, bit n of the masks is the n-th added button.
+   * @return false when the group is full.
+   */
+  bool addButton(OneButton *button);
+
+  /**
+   * Add a chord pattern or replace the function of an existing pattern.
+   * @param mask The buttons of the chord, 2 or more bits.
+   * @param newFunction The function called when the chord is detected.
+   * @return false when the table is full.
+   */
+  bool addChord(const uint8_t mask, callbackFunction newFunction);
+
+  /**
+   * Add a chord pattern or replace the function of an existing pattern.
+   * @param mask The buttons of the chord, 2 or more bits.
+   * @param newFunction The function called when the chord is detected.
+   * @param parameter The parameter passed to the function.
+   * @return false when the table is full.
+   */
+  bool addChord(const uint8_t mask, parameterizedCallbackFunction newFunction, void *parameter);
+
+  /**
+   * set # millisec in which all buttons of a chord must be pressed.
+   */
+  void setChordMs(const unsigned int ms) {
+    _chord_ms = ms;
+  };
+
+  /**
+   * set # millisec a button level must be stable to be taken over.
+   */
+  void setDebounceMs(const unsigned int ms) {
+    _debounce_ms = ms;
+  };
+
+  /**
+   * set # millisec the buttons of a chord must be held together.
+   */
+  void setHoldMs(const unsigned int ms) {
+    _hold_ms = ms;
+  };
+
+  // ----- State machine functions -----
+
+  /**
+   * @brief Call this function every some milliseconds for reading the pins of all buttons.
+   */
+  void tick(void);
+
+  /**
+   * @brief Call this function every some milliseconds with the active levels of all buttons.
+   * @param levels The active levels, bit n is the n-th added button.
+   */
+  void tick(const uint8_t levels);
+
+  /**
+   * Reset the chord detection and the state machines of all buttons.
+   */
+  void reset(void);
+
+  /**
+   * @return The mask of the detected chord while its buttons are held, otherwise 0.
+   */
+  uint8_t activeChord() const {
+    return (_state == CHORD_ACTIVE) ? _chord : 0;
+  };
+
+  /**
+   * @return The debounced active levels of all buttons.
+   */
+  uint8_t pressedMask() const {
+    return _levels;
+  };
+
+  /**
+   * @brief Get the earliest time when tick() must be called next to finish debouncing,
+   * to decide about a chord or to advance the FSM of a button with pending timers.
+   * @param deadline Set to the time in msecs as returned by millis().
+   * @return false when no timer is pending and only a level change can advance the FSMs.
+   */
+  bool nextDeadlineMs(unsigned long &deadline) const;
+
+private:
+  enum chordState_t : uint8_t {
+    CHORD_IDLE = 0,     // no button is pressed.
+    CHORD_COLLECT = 1,  // the pressed buttons can still become a chord.
+    CHORD_ACTIVE = 2,   // a chord was detected, wait for all buttons released.
+    CHORD_PASS = 3,     // no chord, the buttons work on their own until all are released.
+  };
+
+  OneButton *_buttons[ONEBUTTONCHORD_BUTTONS];
+  uint8_t _count = 0;  // number of buttons.
+
+  // the chord patterns sorted by mask.
+  struct pattern_t {
+    uint8_t mask;
+    callbackFunction func;
+    parameterizedCallbackFunction paramFunc;
+    void *param;
+  };
+  pattern_t _patterns[ONEBUTTONCHORD_PATTERNS];
+  uint8_t _patternCount = 0;
+
+  unsigned int _debounce_ms = 20;  // number of msecs for debounce times.
+  unsigned int _chord_ms = 80;     // number of msecs for pressing all buttons of a chord.
+  unsigned int _hold_ms = 50;      // number of msecs for holding a chord.
+
+  chordState_t _state = CHORD_IDLE;
+  uint8_t _raw = 0;      // active levels of the last tick.
+  uint8_t _levels = 0;   // debounced active levels.
+  uint8_t _held = 0;     // buttons with presses held back from the FSM.
+  uint8_t _pending = 0;  // buttons with pending timers in the FSM.
+  uint8_t _chord = 0;    // the detected chord.
+
+  unsigned long _startTime = 0;  // millis() of the first press.
+  unsigned long _matchTime = 0;  // millis() of the last change of the pressed buttons.
+  unsigned long _rawTime[ONEBUTTONCHORD_BUTTONS];    // millis() of the last change of the active levels.
+  unsigned long _pressTime[ONEBUTTONCHORD_BUTTONS];  // millis() of the held back presses.
+
+  bool _addPattern(const uint8_t mask, callbackFunction func, parameterizedCallbackFunction paramFunc, void *param);
+
+  /**
+   * @return The index of the pattern with the mask or -1.
+   */
+  int _find(const uint8_t mask) const;
+
+  /**
+   * @return true when a pattern contains more buttons than the mask.
+   */
+  bool _canGrow(const uint8_t mask) const;
+
+  /**
+   * Pass the held back presses to the FSMs.
+   */
+  void _flush(void);
+
+  void _process(const uint8_t levels, const unsigned long now);
+};
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file OneButtonEventQueue.cpp
+ *
+ * @brief Queue for the events detected by OneButton instances.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonEventQueue.h
+ */
+
+#include "OneButtonEventQueue.h"
+
+// The indices are running freely and only the lower bits address the buffer.
+// Reading the index of the other side uses acquire and publishing the own index uses release
+// semantics so the event data is visible before the index on multi core systems too.
+#define _loadIndex(idx) __atomic_load_n(&(idx), __ATOMIC_ACQUIRE)
+#define _storeIndex(idx, val) __atomic_store_n(&(idx), (val), __ATOMIC_RELEASE)
+
+
+OneButtonEventQueue::OneButtonEventQueue(OneButtonEvent *buffer, const uint8_t size) {
+  _buffer = buffer;
+
+  // use the largest power of 2 fitting into the buffer.
+  uint8_t s = 1;
+  while ((s < 128) && ((s << 1) <= size)) s <<= 1;
+  _mask = s - 1;
+}  // OneButtonEventQueue
+
+
+// add an event, called by the producer.
+bool OneButtonEventQueue::push(const OneButtonEvent &e) {
+  uint8_t head = _head;
+  if ((uint8_t)(head - _loadIndex(_tail)) > _mask) {
+    _dropped++;
+    return false;
+  }
+  _buffer[head & _mask] = e;
+  _storeIndex(_head, (uint8_t)(head + 1));
+  return true;
+}  // push()
+
+
+// remove an event, called by the consumer.
+bool OneButtonEventQueue::pop(OneButtonEvent &e) {
+  uint8_t tail = _tail;
+  if (tail == _loadIndex(_head)) return false;
+  e = _buffer[tail & _mask];
+  _storeIndex(_tail, (uint8_t)(tail + 1));
+  return true;
+}  // pop()
+
+
+uint8_t OneButtonEventQueue::count() const {
+  return (uint8_t)(_loadIndex(_head) - _loadIndex(_tail));
+}  // count()
+
+
+/**
+ * @brief Dispatch the events that are in the queue when starting.
+ * Events added meanwhile are dispatched by the next call.
+ */
+int OneButtonEventQueue::dispatch() {
+  OneButtonEvent e;
+  int n = count();
+
+  for (int i = 0; (i < n) && pop(e); i++) {
+    e.dispatcher(e);
+  }
+  return n;
+}  // dispatch()
+
+
+int OneButtonEventQueue::dispatch(eventHandlerFunction handler) {
+  OneButtonEvent e;
+  int n = count();
+
+  for (int i = 0; (i < n) && pop(e); i++) {
+    handler(e);
+  }
+  return n;
+}  // dispatch()
+
+
+// add an event detected by a button.
+bool OneButtonBase::_pushEvent(OneButtonEventQueue *queue, const OneButtonEvent &e) {
+  return queue->push(e);
+}  // _pushEvent()
+
+
+// end.
@@ -0,0 +1,83 @@
+// -----
+// OneButtonEventQueue.h - Queue for the events detected by OneButton instances
+// to decouple the detection in tick() from calling the event functions.
+// This class is implemented for use with the Arduino environment.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// The queue is a lock-free ring buffer for a single producer and a single consumer:
+// tick() may be called from an interrupt routine and adds the events,
+// the main loop calls dispatch() to remove them and call the event functions.
+// The single producer requires that tick() of all buttons using the queue is called from one
+// context only, e.g. only from a timer interrupt routine and never from the main loop as well.
+// -----
+
+#ifndef OneButtonEventQueue_h
+#define OneButtonEventQueue_h
+
+#include "Arduino.h"
+#include "OneButton.h"
+
+
+class OneButtonEventQueue {
+public:
+  // ----- Constructor -----
+
+  /**
+   * Create a queue using a given buffer for the events.
+   * @param buffer The memory for the queued events.
+   * @param size The number of events in the buffer, a power of 2 up to 128.
+   */
+  OneButtonEventQueue(OneButtonEvent *buffer, const uint8_t size);
+
+  // ----- Producer functions -----
+
+  /**
+   * Add an event to the queue. This function is safe to be called from an interrupt routine.
+   * @return false when the queue is full and the event was dropped.
+   */
+  bool push(const OneButtonEvent &e);
+
+  // ----- Consumer functions -----
+
+  /**
+   * Remove the oldest event from the queue.
+   * @return false when the queue is empty.
+   */
+  bool pop(OneButtonEvent &e);
+
+  /**
+   * Remove all queued events and call the event functions attached to their buttons.
+   * @return The number of dispatched events.
+   */
+  int dispatch();
+
+  /**
+   * Remove all queued events and pass them to a handler function.
+   * @return The number of dispatched events.
+   */
+  int dispatch(eventHandlerFunction handler);
+
+  /**
+   * @return The number of queued events.
+   */
+  uint8_t count() const;
+
+  /**
+   * @return The number of events dropped because the queue was full.
+   */
+  unsigned int dropped() const {
+    return _dropped;
+  };
+
+private:
+  OneButtonEvent *_buffer;
+  uint8_t _mask;              // size - 1 used to wrap the indices.
+  uint8_t _head = 0;          // written by the producer only.
+  uint8_t _tail = 0;          // written by the consumer only.
+  unsigned int _dropped = 0;  // written by the producer only.
+};
+
+#endif
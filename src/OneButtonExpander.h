@@ -0,0 +1,109 @@
+// -----
+// OneButtonExpander.h - Input sources reading the buttons on the common I2C
+// port expanders for the OneButtonInputGroup class. This is implemented for
+// use with the Arduino environment and the Wire library.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// Every read() is one bus transaction for up to 16 inputs.
+// The levels are the raw pin levels: buttons connecting the inputs to GND are
+// active LOW and set by OneButtonInputGroup::setActiveLowMask().
+// This file is not included by OneButton.h so only sketches using an expander
+// depend on the Wire library.
+// -----
+
+#ifndef OneButtonExpander_h
+#define OneButtonExpander_h
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "OneButtonInput.h"
+
+
+/**
+ * The quasi bidirectional PCF8574 (8 inputs) and PCF8575 (16 inputs) expanders.
+ * The pins are inputs with a weak pullup after writing HIGH levels to them.
+ */
+class OneButtonPCF8574 : public OneButtonInputSource {
+public:
+  /**
+   * @param address The I2C address of the expander, 0x20...0x27 for the PCF8574.
+   * @param inputs 8 for the PCF8574 or 16 for the PCF8575.
+   * @param wire The I2C bus.
+   */
+  explicit OneButtonPCF8574(const uint8_t address, const uint8_t inputs = 8, TwoWire &wire = Wire)
+    : _wire(wire), _address(address), _bytes((inputs > 8) ? 2 : 1){};
+
+  bool begin(void) {
+    _wire.beginTransmission(_address);
+    for (uint8_t n = 0; n < _bytes; n++) _wire.write(0xFF);
+    return _wire.endTransmission() == 0;
+  };
+
+  bool read(uint32_t &levels) {
+    if (_wire.requestFrom(_address, _bytes) != _bytes) return false;
+
+    levels = 0;
+    for (uint8_t n = 0; n < _bytes; n++) levels |= (uint32_t)(_wire.read() & 0xFF) << (8 * n);
+    return true;
+  };
+
+private:
+  TwoWire &_wire;
+  uint8_t _address;
+  uint8_t _bytes;  // bytes per read.
+};
+
+
+/**
+ * The MCP23017 expander with 16 inputs in the ports A (inputs 0...7) and B (inputs 8...15)
+ * using the default register layout (IOCON.BANK = 0).
+ * The pins are inputs with the internal pullups enabled.
+ */
+class OneButtonMCP23017 : public OneButtonInputSource {
+public:
+  static constexpr uint8_t REG_IODIRA = 0x00;
+  static constexpr uint8_t REG_GPPUA = 0x0C;
+  static constexpr uint8_t REG_GPIOA = 0x12;
+
+  /**
+   * @param address The I2C address of the expander, 0x20...0x27.
+   * @param wire The I2C bus.
+   */
+  explicit OneButtonMCP23017(const uint8_t address = 0x20, TwoWire &wire = Wire)
+    : _wire(wire), _address(address){};
+
+  bool begin(void) {
+    return _write16(REG_IODIRA, 0xFFFF) && _write16(REG_GPPUA, 0xFFFF);
+  };
+
+  // set the register address and read both ports after a repeated start.
+  bool read(uint32_t &levels) {
+    _wire.beginTransmission(_address);
+    _wire.write(REG_GPIOA);
+    if (_wire.endTransmission(false) != 0) return false;
+    if (_wire.requestFrom(_address, (uint8_t)2) != 2) return false;
+
+    uint8_t a = _wire.read();
+    uint8_t b = _wire.read();
+    levels = ((uint32_t)b << 8) | a;
+    return true;
+  };
+
+private:
+  TwoWire &_wire;
+  uint8_t _address;
+
+  // write a register pair of port A and B.
+  bool _write16(const uint8_t reg, const uint16_t value) {
+    _wire.beginTransmission(_address);
+    _wire.write(reg);
+    _wire.write((uint8_t)(value & 0xFF));
+    _wire.write((uint8_t)(value >> 8));
+    return _wire.endTransmission() == 0;
+  };
+};
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file OneButtonGesture.cpp
+ *
+ * @brief Library for detecting sequences of short and long presses on one button.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonGesture.h
+ */
+
+#include "OneButtonGesture.h"
+
+// ----- Initialization and Default Values -----
+
+OneButtonGesture::OneButtonGesture() {
+  _nodes[0].next[0] = _nodes[0].next[1] = 0;
+  _nodes[0].pattern = -1;
+}  // OneButtonGesture
+
+
+bool OneButtonGesture::addPattern(const char *pattern, callbackFunction newFunction) {
+  return _addPattern(pattern, newFunction, NULL, NULL);
+}  // addPattern()
+
+
+bool OneButtonGesture::addPattern(const char *pattern, parameterizedCallbackFunction newFunction, void *parameter) {
+  return _addPattern(pattern, NULL, newFunction, parameter);
+}  // addPattern()
+
+
+/**
+ * @brief Add the nodes of a pattern to the trie.
+ * The new nodes are only kept when the whole pattern fits.
+ */
+bool OneButtonGesture::_addPattern(const char *pattern, callbackFunction func, parameterizedCallbackFunction paramFunc, void *param) {
+  if ((pattern == NULL) || (_patternCount >= ONEBUTTONGESTURE_PATTERNS)) return false;
+
+  uint8_t nodeCount = _nodeCount;
+  uint8_t node = 0;
+
+  for (const char *p = pattern; *p; p++) {
+    if ((*p != '.') && (*p != '-')) continue;
+    uint8_t isLong = (*p == '-');
+
+    if (_nodes[node].next[isLong] == 0) {
+      if (nodeCount >= ONEBUTTONGESTURE_NODES) {
+        // remove the transitions to the new nodes.
+        for (uint8_t n = 0; n < _nodeCount; n++) {
+          if (_nodes[n].next[0] >= _nodeCount) _nodes[n].next[0] = 0;
+          if (_nodes[n].next[1] >= _nodeCount) _nodes[n].next[1] = 0;
+        }
+        return false;
+      }
+      _nodes[nodeCount].next[0] = _nodes[nodeCount].next[1] = 0;
+      _nodes[nodeCount].pattern = -1;
+      _nodes[node].next[isLong] = nodeCount++;
+    }
+    node = _nodes[node].next[isLong];
+  }
+
+  // an empty or an existing pattern.
+  if ((node == 0) || (_nodes[node].pattern >= 0)) return false;
+
+  _nodeCount = nodeCount;
+  _nodes[node].pattern = _patternCount;
+  _patterns[_patternCount].func = func;
+  _patterns[_patternCount].paramFunc = paramFunc;
+  _patterns[_patternCount].param = param;
+  _patternCount++;
+  return true;
+}  // _addPattern()
+
+
+void OneButtonGesture::reset(void) {
+  _node = 0;
+  _presses = 0;
+}  // reset()
+
+
+// follow the transition of a press, a sequence that left the trie stays at the root until its end.
+void OneButtonGesture::addPress(const unsigned long ms) {
+  if ((_presses == 0) || (_node != 0)) _node = _nodes[_node].next[ms >= _long_ms];
+  if (_presses < 255) _presses++;
+}  // addPress()
+
+
+// call the function of the pattern ending in the current node.
+void OneButtonGesture::endSequence(void) {
+  if (_presses == 0) return;
+
+  int8_t n = _nodes[_node].pattern;
+  reset();
+
+  if (n >= 0) {
+    if (_patterns[n].paramFunc) {
+      _patterns[n].paramFunc(_patterns[n].param);
+    } else if (_patterns[n].func) {
+      _patterns[n].func();
+    }
+  } else if (_unknownFunc) {
+    _unknownFunc();
+  }
+}  // endSequence()
+
+
+bool OneButtonGesture::nextDeadlineMs(unsigned long &deadline) const {
+  if (_level || (_presses == 0)) return false;
+  deadline = _startTime + _pause_ms;
+  return true;
+}  // nextDeadlineMs()
+
+
+/**
+ * @brief Measure the presses and end the sequence after a pause.
+ */
+void OneButtonGesture::tick(const bool level) {
+  unsigned long now = millis();
+
+  if (level != _level) {
+    _level = level;
+    if (!level) addPress(now - _startTime);
+    _startTime = now;
+
+  } else if (!level && _presses && (now - _startTime >= _pause_ms)) {
+    endSequence();
+  }
+}  // tick()
+
+
+// end.
@@ -0,0 +1,153 @@
+// -----
+// OneButtonGesture.h - Library for detecting sequences of short and long
+// presses on one button like ". - ." to select one of many commands.
+// This class is implemented for use with the Arduino environment.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// The patterns are compiled into a trie when they are added. Every node has
+// one transition for a short and one for a long press so the trie is a
+// deterministic finite automaton (DFA) and every press costs one table
+// lookup regardless of the number of patterns. A pause after the last press
+// ends the sequence and the function of the pattern ending in the reached
+// node is called.
+// -----
+
+#ifndef OneButtonGesture_h
+#define OneButtonGesture_h
+
+#include "Arduino.h"
+#include "OneButton.h"
+
+// The maximum number of patterns.
+#ifndef ONEBUTTONGESTURE_PATTERNS
+#define ONEBUTTONGESTURE_PATTERNS 8
+#endif
+
+// The maximum number of trie nodes, about the total length of all patterns.
+#ifndef ONEBUTTONGESTURE_NODES
+#define ONEBUTTONGESTURE_NODES 32
+#endif
+
+
+class OneButtonGesture {
+public:
+  // ----- Constructor -----
+
+  /**
+   * Create a OneButtonGesture instance without patterns.
+   */
+  OneButtonGesture();
+
+  // ----- Set runtime parameters -----
+
+  /**
+   * Add a pattern of short '.' and long '-' presses like ". - .", other characters are ignored.
+   * @param pattern The sequence of presses.
+   * @param newFunction The function called when the sequence is detected.
+   * @return false when the pattern is empty, already added or does not fit into the tables.
+   */
+  bool addPattern(const char *pattern, callbackFunction newFunction);
+
+  /**
+   * Add a pattern of short '.' and long '-' presses like ". - .", other characters are ignored.
+   * @param pattern The sequence of presses.
+   * @param newFunction The function called when the sequence is detected.
+   * @param parameter The parameter passed to the function.
+   * @return false when the pattern is empty, already added or does not fit into the tables.
+   */
+  bool addPattern(const char *pattern, parameterizedCallbackFunction newFunction, void *parameter);
+
+  /**
+   * Attach a function that is called when a sequence matches no pattern.
+   */
+  void attachUnknown(callbackFunction newFunction) {
+    _unknownFunc = newFunction;
+  };
+
+  /**
+   * set # millisec a press must last to be a long press.
+   */
+  void setLongMs(const unsigned int ms) {
+    _long_ms = ms;
+  };
+
+  /**
+   * set # millisec after the last release that end a sequence.
+   */
+  void setPauseMs(const unsigned int ms) {
+    _pause_ms = ms;
+  };
+
+  // ----- State machine functions -----
+
+  /**
+   * @brief Call this function every some milliseconds with the debounced level
+   * of the button, e.g. button.debouncedValue() after button.tick().
+   * @param level The debounced active level.
+   */
+  void tick(const bool level);
+
+  /**
+   * @brief Add a press with its duration, e.g. from a recorded stream of presses.
+   * @param ms The duration of the press in msecs.
+   */
+  void addPress(const unsigned long ms);
+
+  /**
+   * @brief End the sequence and call the function of a matching pattern.
+   */
+  void endSequence(void);
+
+  /**
+   * Reset the current sequence.
+   */
+  void reset(void);
+
+  /**
+   * @return The number of presses of the current sequence.
+   */
+  uint8_t getPressCount() const {
+    return _presses;
+  };
+
+  /**
+   * @brief Get the time when tick() must be called next to end the sequence.
+   * @param deadline Set to the time in msecs as returned by millis().
+   * @return false when no sequence is waiting for its end.
+   */
+  bool nextDeadlineMs(unsigned long &deadline) const;
+
+private:
+  // a node of the trie with the transitions for a short and a long press.
+  struct node_t {
+    uint8_t next[2];  // 0: no transition as the root is never a target.
+    int8_t pattern;   // index of the pattern ending here or -1.
+  };
+  node_t _nodes[ONEBUTTONGESTURE_NODES];
+  uint8_t _nodeCount = 1;
+
+  struct pattern_t {
+    callbackFunction func;
+    parameterizedCallbackFunction paramFunc;
+    void *param;
+  };
+  pattern_t _patterns[ONEBUTTONGESTURE_PATTERNS];
+  uint8_t _patternCount = 0;
+
+  callbackFunction _unknownFunc = NULL;
+
+  unsigned int _long_ms = 400;   // number of msecs for a long press.
+  unsigned int _pause_ms = 800;  // number of msecs for the end of a sequence.
+
+  bool _level = false;           // debounced level of the last tick.
+  uint8_t _node = 0;             // current node, 0 while no press matches.
+  uint8_t _presses = 0;          // number of presses of the current sequence.
+  unsigned long _startTime = 0;  // millis() of the last press or release.
+
+  bool _addPattern(const char *pattern, callbackFunction func, parameterizedCallbackFunction paramFunc, void *param);
+};
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file OneButtonInput.cpp
+ *
+ * @brief Library for detecting button clicks, doubleclicks and long press
+ * pattern on up to 32 buttons that are read together from an input source.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonInput.h
+ */
+
+#include "OneButtonInput.h"
+
+// ----- Initialization and Default Values -----
+
+OneButtonInputGroup::OneButtonInputGroup(OneButtonInputSource *source)
+  : _source(source) {
+  for (int n = 0; n < ONEBUTTONINPUT_LANES; n++) _buttons[n] = NULL;
+}  // OneButtonInputGroup
+
+
+// attach or detach a button for a lane.
+void OneButtonInputGroup::attach(const uint8_t lane, OneButton *button) {
+  if (lane >= ONEBUTTONINPUT_LANES) return;
+
+  uint32_t bit = (uint32_t)1 << lane;
+  _buttons[lane] = button;
+  _pending &= ~bit;
+
+  if (button) {
+    _attached |= bit;
+    _pending |= bit;  // take over the current level with the next tick.
+  } else {
+    _attached &= ~bit;
+  }
+}  // attach
+
+
+bool OneButtonInputGroup::begin(void) {
+  if (!_source || !_source->begin()) return false;
+  _source->request();
+  return true;
+}  // begin()
+
+
+void OneButtonInputGroup::reset(void) {
+  _pending = _attached;
+  for (uint8_t lane = 0; lane < ONEBUTTONINPUT_LANES; lane++) {
+    if (_buttons[lane]) _buttons[lane]->reset();
+  }
+}  // reset()
+
+
+// get the earliest deadline of the pending buttons.
+bool OneButtonInputGroup::nextDeadlineMs(unsigned long &deadline) const {
+  bool found = false;
+  unsigned long ms;
+
+  uint32_t lanes = _pending;
+  while (lanes) {
+    uint8_t lane = __builtin_ctzl(lanes);
+    lanes &= lanes - 1;
+    if (_buttons[lane]->nextDeadlineMs(ms) && (!found || ((long)(ms - deadline) < 0))) {
+      deadline = ms;
+      found = true;
+    }
+  }
+  return found;
+}  // nextDeadlineMs()
+
+
+/**
+ * @brief Read the levels of all inputs with one transaction and advance the finite state
+ * machines (FSM) of the changed and the pending buttons.
+ */
+void OneButtonInputGroup::tick(void) {
+  uint32_t lanes = _pending;
+  uint32_t levels;
+
+  if (_source && _source->read(levels)) {
+    levels ^= _activeLowMask;
+    lanes |= (levels ^ _levels) & _attached;
+    _levels = levels;
+    _reads++;
+    _source->request();  // start the next transfer.
+  }
+
+  unsigned long now = millis();  // one time for all buttons.
+  while (lanes) {
+    uint8_t lane = __builtin_ctzl(lanes);
+    uint32_t bit = (uint32_t)1 << lane;
+    lanes &= lanes - 1;
+
+    OneButton *b = _buttons[lane];
+    bool level = (_levels & bit) != 0;
+    b->tickAt(level, now);
+
+    // wait for the end of the timers and of debouncing.
+    if (b->isPending() || (b->debouncedValue() != level)) {
+      _pending |= bit;
+    } else {
+      _pending &= ~bit;
+    }
+  }
+}  // tick()
+
+
+// end.
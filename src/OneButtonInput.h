@@ -0,0 +1,139 @@
+// -----
+// OneButtonInput.h - Library for detecting button clicks, doubleclicks and
+// long press pattern on up to 32 buttons that are read together from an input
+// source like an I2C port expander. This class is implemented for use with the
+// Arduino environment.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// An input source reads the levels of all its inputs with one bus transaction
+// instead of one digitalRead() per button. Sources with an asynchronous bus
+// start the transfer by request() and deliver the levels by a later read().
+// The OneButtonInputGroup reads the source once per tick() and advances only
+// the buttons with a changed level or with pending timers or debouncing.
+// -----
+
+#ifndef OneButtonInput_h
+#define OneButtonInput_h
+
+#include "Arduino.h"
+#include "OneButton.h"
+
+#define ONEBUTTONINPUT_LANES 32
+
+
+/**
+ * The interface of a source providing the levels of many inputs per read.
+ * See OneButtonExpander.h for the sources of the common I2C port expanders.
+ */
+class OneButtonInputSource {
+public:
+  virtual ~OneButtonInputSource(){};
+
+  /**
+   * Initialize the device, e.g. configure the pins of an expander as inputs.
+   * @return false when the device does not respond.
+   */
+  virtual bool begin(void) {
+    return true;
+  };
+
+  /**
+   * Start reading the levels of all inputs.
+   * An asynchronous source starts a bus transfer that runs in the background.
+   * A synchronous source reads the levels in read() and does nothing here.
+   */
+  virtual void request(void){};
+
+  /**
+   * Get the levels of all inputs with bit n for input n.
+   * @param levels Set to the levels of the inputs.
+   * @return false when no levels are available, e.g. while a transfer is running or on a bus error.
+   */
+  virtual bool read(uint32_t &levels) = 0;
+};
+
+
+class OneButtonInputGroup {
+public:
+  // ----- Constructor -----
+
+  /**
+   * Create a OneButtonInputGroup instance without any buttons attached.
+   * @param source The source of the input levels.
+   */
+  explicit OneButtonInputGroup(OneButtonInputSource *source = NULL);
+
+  // ----- Set runtime parameters -----
+
+  /**
+   * Set the source of the input levels.
+   */
+  void setSource(OneButtonInputSource *source) {
+    _source = source;
+  };
+
+  /**
+   * Attach a OneButton instance to an input of the source.
+   * The button should be created without a pin as the level is given by the source.
+   * @param lane The input number 0...31 of the source.
+   * @param button The button to be used for this input or NULL to detach a button.
+   */
+  void attach(const uint8_t lane, OneButton *button);
+
+  /**
+   * Set the inputs that are active LOW, e.g. 0xFFFF for 16 buttons connecting the inputs to GND.
+   * Default is 0: all inputs are active HIGH.
+   */
+  void setActiveLowMask(const uint32_t mask) {
+    _activeLowMask = mask;
+  };
+
+  /**
+   * Initialize the source and start the first transfer.
+   * @return false when the source does not respond.
+   */
+  bool begin(void);
+
+  // ----- State machine functions -----
+
+  /**
+   * @brief Read the source once and advance the FSMs of the buttons with a changed level
+   * and of the buttons with pending timers or debouncing.
+   * Call this function in the main loop.
+   */
+  void tick(void);
+
+  /**
+   * Reset the state machines of all buttons and take over the levels of the next read.
+   */
+  void reset(void);
+
+  /**
+   * @brief Get the earliest deadline of the attached buttons.
+   * @param deadline Set to the time in msecs as returned by millis().
+   * @return false when no timer is pending.
+   */
+  bool nextDeadlineMs(unsigned long &deadline) const;
+
+  /**
+   * @return The number of successful reads of the source.
+   */
+  unsigned long getReads() const {
+    return _reads;
+  };
+
+private:
+  OneButtonInputSource *_source;
+  OneButton *_buttons[ONEBUTTONINPUT_LANES];
+  uint32_t _attached = 0;       // lanes with a button.
+  uint32_t _activeLowMask = 0;  // lanes that are active LOW.
+
+  uint32_t _levels = 0;   // active levels of the last read.
+  uint32_t _pending = 0;  // lanes with pending timers or debouncing.
+  unsigned long _reads = 0;
+};
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file OneButtonManager.cpp
+ *
+ * @brief Scanning many OneButtonFull instances in a separate thread and calling
+ * the event functions from a worker thread.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonManager.h
+ */
+
+#include "OneButtonManager.h"
+
+#ifdef ONEBUTTONMANAGER_SUPPORTED
+
+// ----- Initialization and Default Values -----
+
+OneButtonManager::OneButtonManager(OneButtonEvent *buffer, const uint8_t size)
+  : _queue(buffer, size) {
+  for (int n = 0; n < ONEBUTTONMANAGER_BUTTONS; n++) _buttons[n] = NULL;
+}  // OneButtonManager
+
+
+OneButtonManager::~OneButtonManager() {
+  end();
+}  // ~OneButtonManager
+
+
+// add a button to be scanned.
+bool OneButtonManager::add(OneButtonFull *button) {
+  if (running() || (_count >= ONEBUTTONMANAGER_BUTTONS)) return false;
+
+  button->setEventQueue(&_queue);
+  _buttons[_count++] = button;
+  return true;
+}  // add()
+
+
+// tick all buttons once using one time for all buttons.
+void OneButtonManager::_scan() {
+  const OneButtonFull::time_type now = OneButtonFull::clock_type::now();
+
+  for (uint8_t n = 0; n < _count; n++) {
+    _buttons[n]->tickAt(now);
+  }
+  __atomic_store_n(&_scans, _scans + 1, __ATOMIC_RELAXED);
+
+  if (_queue.count()) _signal();
+}  // _scan()
+
+
+#if defined(ONEBUTTON_STD_THREAD)
+
+// ----- Threads using std::thread -----
+
+bool OneButtonManager::begin() {
+  if (running()) return false;
+
+  _signaled = false;
+  __atomic_store_n(&_running, true, __ATOMIC_RELEASE);
+  _workerThread = std::thread(&OneButtonManager::_workerLoop, this);
+  _scanThread = std::thread(&OneButtonManager::_scanLoop, this);
+  return true;
+}  // begin()
+
+
+void OneButtonManager::end() {
+  if (!running()) return;
+
+  __atomic_store_n(&_running, false, __ATOMIC_RELEASE);
+  _scanThread.join();
+  _signal();
+  _workerThread.join();
+
+  // the events detected by the last scans.
+  _queue.dispatch();
+}  // end()
+
+
+void OneButtonManager::_signal() {
+  std::lock_guard<std::mutex> lock(_wakeMutex);
+  _signaled = true;
+  _wake.notify_one();
+}  // _signal()
+
+
+/**
+ * @brief Scan all buttons at a fixed cadence.
+ * A late scan does not shorten the following interval.
+ */
+void OneButtonManager::_scanLoop() {
+  std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+
+  while (running()) {
+    _scan();
+
+    next += std::chrono::milliseconds(_scan_ms);
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (next < now) {
+      __atomic_store_n(&_overruns, _overruns + 1, __ATOMIC_RELAXED);
+      next = now;
+    }
+    std::this_thread::sleep_until(next);
+  }
+}  // _scanLoop()
+
+
+// dispatch the events when signaled.
+void OneButtonManager::_workerLoop() {
+  while (running()) {
+    {
+      std::unique_lock<std::mutex> lock(_wakeMutex);
+      _wake.wait(lock, [this] {
+        return _signaled || !running();
+      });
+      _signaled = false;
+    }
+    _queue.dispatch();
+  }
+}  // _workerLoop()
+
+
+#else
+
+// ----- Threads using FreeRTOS tasks -----
+
+bool OneButtonManager::begin() {
+  if (running()) return false;
+
+  __atomic_store_n(&_running, true, __ATOMIC_RELEASE);
+  if (xTaskCreate(_workerTaskFunc, "OneButtonWorker", ONEBUTTONMANAGER_STACK, this, ONEBUTTONMANAGER_WORKER_PRIORITY, &_workerTask) != pdPASS) {
+    _workerTask = NULL;
+    __atomic_store_n(&_running, false, __ATOMIC_RELEASE);
+    return false;
+  }
+  if (xTaskCreate(_scanTaskFunc, "OneButtonScan", ONEBUTTONMANAGER_STACK, this, ONEBUTTONMANAGER_SCAN_PRIORITY, &_scanTask) != pdPASS) {
+    _scanTask = NULL;
+    end();
+    return false;
+  }
+  return true;
+}  // begin()
+
+
+void OneButtonManager::end() {
+  if (!running()) return;
+
+  __atomic_store_n(&_running, false, __ATOMIC_RELEASE);
+
+  // the tasks clear their handle before deleting themselves.
+  while (__atomic_load_n(&_scanTask, __ATOMIC_ACQUIRE)) vTaskDelay(1);
+  while (__atomic_load_n(&_workerTask, __ATOMIC_ACQUIRE)) {
+    _signal();
+    vTaskDelay(1);
+  }
+
+  // the events detected by the last scans.
+  _queue.dispatch();
+}  // end()
+
+
+void OneButtonManager::_signal() {
+  TaskHandle_t task = __atomic_load_n(&_workerTask, __ATOMIC_ACQUIRE);
+  if (task) xTaskNotifyGive(task);
+}  // _signal()
+
+
+/**
+ * @brief Scan all buttons at a fixed cadence.
+ * A late scan does not shorten the following interval.
+ */
+void OneButtonManager::_scanLoop() {
+  const TickType_t interval = max((TickType_t)1, (TickType_t)pdMS_TO_TICKS(_scan_ms));
+  TickType_t lastWake = xTaskGetTickCount();
+
+  while (running()) {
+    _scan();
+
+    if ((TickType_t)(xTaskGetTickCount() - lastWake) >= interval) {
+      __atomic_store_n(&_overruns, _overruns + 1, __ATOMIC_RELAXED);
+      lastWake = xTaskGetTickCount();
+    }
+    vTaskDelayUntil(&lastWake, interval);
+  }
+}  // _scanLoop()
+
+
+// dispatch the events when notified.
+void OneButtonManager::_workerLoop() {
+  while (running()) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    _queue.dispatch();
+  }
+}  // _workerLoop()
+
+
+void OneButtonManager::_scanTaskFunc(void *param) {
+  OneButtonManager *m = (OneButtonManager *)param;
+  m->_scanLoop();
+  __atomic_store_n(&m->_scanTask, (TaskHandle_t)NULL, __ATOMIC_RELEASE);
+  vTaskDelete(NULL);
+}  // _scanTaskFunc()
+
+
+void OneButtonManager::_workerTaskFunc(void *param) {
+  OneButtonManager *m = (OneButtonManager *)param;
+  m->_workerLoop();
+  __atomic_store_n(&m->_workerTask, (TaskHandle_t)NULL, __ATOMIC_RELEASE);
+  vTaskDelete(NULL);
+}  // _workerTaskFunc()
+
+#endif
+
+#endif
+
+// end.
@@ -0,0 +1,182 @@
+// -----
+// OneButtonManager.h - Scanning many OneButtonFull instances in a separate thread
+// and calling the event functions from a worker thread.
+// This class is implemented for use with the Arduino environment on ESP32 and
+// for host systems using std::thread.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// The scan thread ticks all buttons at a fixed cadence. The detected events are
+// added to a lock-free event queue and the worker thread is woken up to dispatch
+// them. So slow event functions never delay the scanning of the other buttons.
+// On ESP32 FreeRTOS tasks are used, on host systems the library must be compiled
+// with ONEBUTTON_STD_THREAD defined.
+// -----
+
+#ifndef OneButtonManager_h
+#define OneButtonManager_h
+
+#if defined(ONEBUTTON_STD_THREAD) || defined(ESP32) || defined(ESP_PLATFORM)
+#define ONEBUTTONMANAGER_SUPPORTED
+#endif
+
+#ifdef ONEBUTTONMANAGER_SUPPORTED
+
+#include "Arduino.h"
+#include "OneButton.h"
+#include "OneButtonEventQueue.h"
+
+#if defined(ONEBUTTON_STD_THREAD)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#else
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+// The maximum number of buttons per manager.
+#ifndef ONEBUTTONMANAGER_BUTTONS
+#define ONEBUTTONMANAGER_BUTTONS 16
+#endif
+
+// FreeRTOS task settings.
+#ifndef ONEBUTTONMANAGER_STACK
+#define ONEBUTTONMANAGER_STACK 4096
+#endif
+#ifndef ONEBUTTONMANAGER_SCAN_PRIORITY
+#define ONEBUTTONMANAGER_SCAN_PRIORITY 5
+#endif
+#ifndef ONEBUTTONMANAGER_WORKER_PRIORITY
+#define ONEBUTTONMANAGER_WORKER_PRIORITY 2
+#endif
+
+
+class OneButtonManager {
+public:
+  // ----- Constructor -----
+
+  /**
+   * Create a manager using a given buffer for the event queue.
+   * @param buffer The memory for the queued events.
+   * @param size The number of events in the buffer, a power of 2 up to 128.
+   * The buffer must hold all events detected while an event function is running.
+   */
+  OneButtonManager(OneButtonEvent *buffer, const uint8_t size);
+
+  /**
+   * Stop the threads.
+   */
+  ~OneButtonManager();
+
+  // ----- Set runtime parameters -----
+
+  /**
+   * Add a button that is scanned by the manager.
+   * The events of the button are queued by the manager from now on,
+   * so the button must be an OneButtonFull supporting the event queue.
+   * Buttons can only be added while the manager is not running.
+   * @return false when the manager is full or running.
+   */
+  bool add(OneButtonFull *button);
+
+  /**
+   * set # millisec between 2 scans of all buttons.
+   */
+  void setScanMs(const unsigned int ms) {
+    _scan_ms = (ms > 0) ? ms : 1;
+  };
+
+  // ----- Thread functions -----
+
+  /**
+   * Start the scan and the worker thread.
+   * @return false when the threads could not be started.
+   */
+  bool begin();
+
+  /**
+   * Stop the scan and the worker thread.
+   * Events remaining in the queue are dispatched by the calling thread.
+   */
+  void end();
+
+  /**
+   * @return true while the threads are running.
+   */
+  bool running() const {
+    return __atomic_load_n(&_running, __ATOMIC_ACQUIRE);
+  };
+
+  // ----- Statistics -----
+
+  /**
+   * @return The number of scans of all buttons.
+   */
+  unsigned long scans() const {
+    return __atomic_load_n(&_scans, __ATOMIC_RELAXED);
+  };
+
+  /**
+   * @return The number of scans that started later than the scan interval.
+   */
+  unsigned long overruns() const {
+    return __atomic_load_n(&_overruns, __ATOMIC_RELAXED);
+  };
+
+  /**
+   * @return The number of events dropped because the queue was full.
+   */
+  unsigned int dropped() const {
+    return _queue.dropped();
+  };
+
+private:
+  OneButtonEventQueue _queue;
+
+  OneButtonFull *_buttons[ONEBUTTONMANAGER_BUTTONS];
+  uint8_t _count = 0;
+
+  unsigned int _scan_ms = 5;  // number of msecs between 2 scans.
+
+  bool _running = false;        // written by begin() and end() only.
+  unsigned long _scans = 0;     // written by the scan thread only.
+  unsigned long _overruns = 0;  // written by the scan thread only.
+
+#if defined(ONEBUTTON_STD_THREAD)
+  std::thread _scanThread;
+  std::thread _workerThread;
+
+  // used for waking up the worker, the events are passed by the lock-free queue.
+  std::mutex _wakeMutex;
+  std::condition_variable _wake;
+  bool _signaled = false;
+#else
+  TaskHandle_t _scanTask = NULL;
+  TaskHandle_t _workerTask = NULL;
+
+  static void _scanTaskFunc(void *param);
+  static void _workerTaskFunc(void *param);
+#endif
+
+  /**
+   * Tick all buttons once.
+   */
+  void _scan();
+
+  /**
+   * The loops of the threads.
+   */
+  void _scanLoop();
+  void _workerLoop();
+
+  /**
+   * Wake up the worker thread.
+   */
+  void _signal();
+};
+
+#endif
+#endif
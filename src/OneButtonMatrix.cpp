@@ -0,0 +1,204 @@
+/**
+ * @file OneButtonMatrix.cpp
+ *
+ * @brief Library for detecting button clicks, doubleclicks and long press
+ * pattern on the keys of a button matrix.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonMatrix.h
+ */
+
+#include "OneButtonMatrix.h"
+
+// ----- Initialization and Default Values -----
+
+OneButtonMatrix::OneButtonMatrix(const uint8_t *rowPins, const uint8_t rows, const uint8_t *colPins, const uint8_t cols) {
+  _rows = min(rows, (uint8_t)ONEBUTTONMATRIX_ROWS);
+  _cols = min(cols, (uint8_t)ONEBUTTONMATRIX_COLS);
+
+  for (uint8_t r = 0; r < ONEBUTTONMATRIX_ROWS; r++) {
+    _rowPins[r] = (r < _rows) ? rowPins[r] : 0;
+    for (uint8_t c = 0; c < ONEBUTTONMATRIX_COLS; c++) _buttons[r][c] = NULL;
+    _attached[r] = _pending[r] = 0;
+    _levels[r] = _raw[r] = 0;
+    _rawTime[r] = 0;
+  }
+  for (uint8_t c = 0; c < ONEBUTTONMATRIX_COLS; c++) {
+    _colPins[c] = (c < _cols) ? colPins[c] : 0;
+  }
+}  // OneButtonMatrix
+
+
+void OneButtonMatrix::begin(void) {
+  for (uint8_t r = 0; r < _rows; r++) pinMode(_rowPins[r], INPUT);
+  for (uint8_t c = 0; c < _cols; c++) pinMode(_colPins[c], INPUT_PULLUP);
+}  // begin()
+
+
+// attach or detach a button for a key.
+void OneButtonMatrix::attach(const uint8_t row, const uint8_t col, OneButton *button) {
+  if ((row >= _rows) || (col >= _cols)) return;
+
+  uint8_t bit = 1 << col;
+  _buttons[row][col] = button;
+  _pending[row] &= ~bit;
+
+  if (button) {
+    _attached[row] |= bit;
+    if (button->isPending()) _pending[row] |= bit;
+  } else {
+    _attached[row] &= ~bit;
+  }
+}  // attach
+
+
+void OneButtonMatrix::reset(void) {
+  unsigned long now = millis();
+  _unstable = _ghostRows = 0;
+
+  for (uint8_t r = 0; r < _rows; r++) {
+    _levels[r] = _raw[r] = 0;
+    _rawTime[r] = now;
+    _pending[r] = 0;
+
+    for (uint8_t c = 0; c < _cols; c++) {
+      OneButton *b = _buttons[r][c];
+      if (b) {
+        b->reset();
+        if (b->isPending()) _pending[r] |= (1 << c);
+      }
+    }
+  }
+}  // reset()
+
+
+// drive one row LOW and read the columns, all other rows are not driven.
+uint8_t OneButtonMatrix::_scanRow(const uint8_t row) {
+  uint8_t cols = 0;
+
+  pinMode(_rowPins[row], OUTPUT);
+  digitalWrite(_rowPins[row], LOW);
+  if (_settle_us) delayMicroseconds(_settle_us);
+
+  if (_readColumns) {
+    cols = _readColumns(row);
+  } else {
+    for (uint8_t c = 0; c < _cols; c++) {
+      if (digitalRead(_colPins[c]) == LOW) cols |= (1 << c);
+    }
+  }
+
+  pinMode(_rowPins[row], INPUT);
+  return cols;
+}  // _scanRow()
+
+
+/**
+ * @brief Find the rows with a possible ghost key.
+ * 3 pressed keys at the corners of a rectangle are read as 4 pressed keys
+ * so 2 rows sharing 2 or more active columns cannot be decoded.
+ */
+uint8_t OneButtonMatrix::_findGhostRows(const uint8_t *cols) const {
+  uint8_t rows = 0;
+
+  for (uint8_t r1 = 0; r1 < _rows; r1++) {
+    if ((cols[r1] & (cols[r1] - 1)) == 0) continue;  // less than 2 columns.
+    for (uint8_t r2 = r1 + 1; r2 < _rows; r2++) {
+      uint8_t shared = cols[r1] & cols[r2];
+      if (shared & (shared - 1)) rows |= (1 << r1) | (1 << r2);
+    }
+  }
+  return rows;
+}  // _findGhostRows()
+
+
+// get the earliest deadline of debouncing and all pending buttons.
+bool OneButtonMatrix::nextDeadlineMs(unsigned long &deadline) const {
+  bool found = false;
+  unsigned long ms;
+
+  for (uint8_t r = 0; r < _rows; r++) {
+    // the columns of this row are waiting to be stable.
+    if (_unstable & (1 << r)) {
+      ms = _rawTime[r] + _debounce_ms;
+      if (!found || ((long)(ms - deadline) < 0)) {
+        deadline = ms;
+        found = true;
+      }
+    }
+
+    uint8_t cols = _pending[r] & _attached[r];
+    while (cols) {
+      uint8_t c = __builtin_ctz(cols);
+      cols &= ~(1 << c);
+
+      if (_buttons[r][c]->nextDeadlineMs(ms) && (!found || ((long)(ms - deadline) < 0))) {
+        deadline = ms;
+        found = true;
+      }
+    }
+  }
+  return found;
+}  // nextDeadlineMs()
+
+
+/**
+ * @brief Scan all rows, block ambiguous rows, debounce the rows and then
+ * advance the finite state machines (FSM) of the changed or pending keys only.
+ */
+void OneButtonMatrix::tick(void) {
+  unsigned long now = millis();  // one time for all buttons.
+  uint8_t cols[ONEBUTTONMATRIX_ROWS];
+
+  for (uint8_t r = 0; r < _rows; r++) cols[r] = _scanRow(r);
+
+  _ghostRows = _diodes ? 0 : _findGhostRows(cols);
+  if (_ghostRows) _ghostScans++;
+
+  _unstable = 0;
+  for (uint8_t r = 0; r < _rows; r++) {
+    uint8_t bit = 1 << r;
+    uint8_t changed = 0;
+
+    // ambiguous rows keep their levels.
+    uint8_t sample = (_ghostRows & bit) ? _levels[r] : cols[r];
+    if (sample != _raw[r]) {
+      _raw[r] = sample;
+      _rawTime[r] = now;
+    }
+
+    if (_raw[r] != _levels[r]) {
+      if (now - _rawTime[r] >= _debounce_ms) {
+        changed = _raw[r] ^ _levels[r];
+        _levels[r] = _raw[r];
+      } else {
+        _unstable |= bit;
+      }
+    }
+
+    uint8_t keys = (changed | _pending[r]) & _attached[r];
+    while (keys) {
+      uint8_t c = __builtin_ctz(keys);
+      uint8_t key = 1 << c;
+      keys &= ~key;
+
+      OneButton *b = _buttons[r][c];
+      b->tickDebounced(_levels[r] & key, now);
+      if (b->isPending()) {
+        _pending[r] |= key;
+      } else {
+        _pending[r] &= ~key;
+      }
+    }
+  }
+}  // tick()
+
+
+// end.
@@ -0,0 +1,181 @@
+// -----
+// OneButtonMatrix.h - Library for detecting button clicks, doubleclicks and
+// long press pattern on the keys of a button matrix.
+// This class is implemented for use with the Arduino environment.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// Every scan drives the rows LOW one after the other and reads the columns
+// into a level bitmap with one byte per row. By default every column is read
+// by digitalRead(), so an 8x8 matrix takes 64 reads per scan. The 8 reads per
+// scan of an 8x8 matrix need a column reader set by setColumnReader(). In a matrix without diodes 3
+// pressed keys at the corners of a rectangle also connect the 4th key, so
+// rows sharing 2 or more pressed columns are ambiguous and keep their
+// previous levels until the ambiguity is resolved.
+// The rows are debounced on their own and only the keys with a changed level
+// or with pending timers advance their finite state machine.
+// -----
+
+#ifndef OneButtonMatrix_h
+#define OneButtonMatrix_h
+
+#include "Arduino.h"
+#include "OneButton.h"
+
+// The rows and the columns of a row are stored as bits in one byte.
+#define ONEBUTTONMATRIX_ROWS 8
+#define ONEBUTTONMATRIX_COLS 8
+
+
+class OneButtonMatrix {
+public:
+  /**
+   * Function reading the columns while a row is driven.
+   * @param row The row number.
+   * @return The active columns, bit 0 is the first column.
+   */
+  typedef uint8_t (*columnReaderFunction)(uint8_t row);
+
+  // ----- Constructor -----
+
+  /**
+   * Create a OneButtonMatrix instance.
+   * @param rowPins The pins of the rows that are driven LOW while scanning.
+   * @param rows The number of rows.
+   * @param colPins The pins of the columns that are read with pullup.
+   * @param cols The number of columns.
+   */
+  OneButtonMatrix(const uint8_t *rowPins, const uint8_t rows, const uint8_t *colPins, const uint8_t cols);
+
+  /**
+   * Initialize the row and column pins.
+   */
+  void begin(void);
+
+  // ----- Set runtime parameters -----
+
+  /**
+   * Attach a OneButton instance to a key or detach it.
+   * The button should be created without a pin as the level is given by the matrix.
+   * @param row The row of the key.
+   * @param col The column of the key.
+   * @param button The button to be used for this key or NULL to detach a button.
+   */
+  void attach(const uint8_t row, const uint8_t col, OneButton *button);
+
+  /**
+   * Read all columns of the driven row by one function, e.g. from a port register,
+   * instead of one digitalRead() per column. Pass NULL to use digitalRead() again.
+   */
+  void setColumnReader(columnReaderFunction newFunction) {
+    _readColumns = newFunction;
+  };
+
+  /**
+   * Set to true when every key has a diode so any combination of keys can be detected.
+   * Default is false: ambiguous combinations are blocked.
+   */
+  void setDiodes(const bool diodes) {
+    _diodes = diodes;
+  };
+
+  /**
+   * set # microsec to wait after driving a row before the columns are read,
+   * e.g. for long wires or weak pullups. Default is 0.
+   */
+  void setSettleUs(const unsigned int us) {
+    _settle_us = us;
+  };
+
+  /**
+   * set # millisec the columns of a row must be stable to be taken over.
+   */
+  void setDebounceMs(const unsigned int ms) {
+    _debounce_ms = ms;
+  };
+
+  // ----- State machine functions -----
+
+  /**
+   * @brief Call this function every some milliseconds for scanning the matrix.
+   */
+  void tick(void);
+
+  /**
+   * Reset the debouncing and the state machines of all attached buttons.
+   */
+  void reset(void);
+
+  /**
+   * @return The debounced active columns of a row.
+   */
+  uint8_t levels(const uint8_t row) const {
+    return (row < _rows) ? _levels[row] : 0;
+  };
+
+  /**
+   * @return The active columns of a row read by the last scan.
+   * Rows with an ambiguous combination return their debounced levels.
+   */
+  uint8_t rawLevels(const uint8_t row) const {
+    return (row < _rows) ? _raw[row] : 0;
+  };
+
+  /**
+   * @return true when the last scan found an ambiguous combination of keys.
+   */
+  bool isGhosting() const {
+    return _ghostRows != 0;
+  };
+
+  /**
+   * @return The number of scans that found an ambiguous combination of keys.
+   */
+  unsigned long ghostScans() const {
+    return _ghostScans;
+  };
+
+  /**
+   * @brief Get the earliest time when tick() must be called next to finish debouncing
+   * or to advance the FSM of a button with pending timers.
+   * @param deadline Set to the time in msecs as returned by millis().
+   * @return false when no timer is pending and only a level change can advance the FSMs.
+   */
+  bool nextDeadlineMs(unsigned long &deadline) const;
+
+private:
+  uint8_t _rowPins[ONEBUTTONMATRIX_ROWS];
+  uint8_t _colPins[ONEBUTTONMATRIX_COLS];
+  uint8_t _rows;
+  uint8_t _cols;
+
+  OneButton *_buttons[ONEBUTTONMATRIX_ROWS][ONEBUTTONMATRIX_COLS];
+  uint8_t _attached[ONEBUTTONMATRIX_ROWS];  // columns with attached buttons per row.
+  uint8_t _pending[ONEBUTTONMATRIX_ROWS];   // columns with pending timers in the FSM per row.
+
+  columnReaderFunction _readColumns = NULL;
+  bool _diodes = false;
+  unsigned int _debounce_ms = 20;  // number of msecs for debounce times.
+  unsigned int _settle_us = 0;     // number of usecs for the columns to follow a driven row.
+
+  uint8_t _levels[ONEBUTTONMATRIX_ROWS];           // debounced active columns per row.
+  uint8_t _raw[ONEBUTTONMATRIX_ROWS];              // active columns of the last scan per row.
+  unsigned long _rawTime[ONEBUTTONMATRIX_ROWS];    // millis() of the last change of the raw columns per row.
+  uint8_t _unstable = 0;                           // rows with raw columns differing from the levels.
+  uint8_t _ghostRows = 0;                          // rows with an ambiguous combination.
+  unsigned long _ghostScans = 0;
+
+  /**
+   * Drive one row and read its columns.
+   */
+  uint8_t _scanRow(const uint8_t row);
+
+  /**
+   * @return The rows sharing 2 or more active columns with another row.
+   */
+  uint8_t _findGhostRows(const uint8_t *cols) const;
+};
+
+#endif
@@ -0,0 +1,197 @@
+/**
+ * @file OneButtonPinGroup.cpp
+ *
+ * @brief Library for detecting button clicks, doubleclicks and long press
+ * pattern on up to 32 buttons sharing one pin change interrupt routine.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonPinGroup.h
+ */
+
+#include "OneButtonPinGroup.h"
+
+OneButtonPinGroup *OneButtonPinGroup::_groups[ONEBUTTONPINGROUP_GROUPS] = { NULL, NULL, NULL, NULL };
+
+// every slot has its own interrupt routine as attachInterrupt() passes no parameter.
+template<int N>
+ONEBUTTON_ISR_ATTR void OneButtonPinGroup::_handler(void) {
+  OneButtonPinGroup *g = _groups[N];
+  if (g) g->isr();
+}  // _handler()
+
+void (*const OneButtonPinGroup::_handlers[ONEBUTTONPINGROUP_GROUPS])(void) = {
+  _handler<0>, _handler<1>, _handler<2>, _handler<3>
+};
+
+
+// ----- Initialization and Default Values -----
+
+OneButtonPinGroup::OneButtonPinGroup() {
+  for (int n = 0; n < ONEBUTTONPINGROUP_LANES; n++) _buttons[n] = NULL;
+}  // OneButtonPinGroup
+
+
+OneButtonPinGroup::~OneButtonPinGroup() {
+  end();
+}  // ~OneButtonPinGroup
+
+
+// attach or detach a button for a lane.
+void OneButtonPinGroup::attach(const uint8_t lane, OneButton *button) {
+  if (lane >= ONEBUTTONPINGROUP_LANES) return;
+
+  uint32_t bit = (uint32_t)1 << lane;
+  _buttons[lane] = button;
+  _pending &= ~bit;
+
+  if (button) {
+    _attached |= bit;
+    _pending |= bit;  // take over the current level with the next tick.
+  } else {
+    _attached &= ~bit;
+  }
+}  // attach
+
+
+// register the interrupt routine of a free slot on all pins.
+bool OneButtonPinGroup::begin() {
+  // all pins need an interrupt, e.g. only the pins 2 and 3 have one on the Arduino UNO.
+  for (uint8_t lane = 0; lane < ONEBUTTONPINGROUP_LANES; lane++) {
+    OneButton *b = _buttons[lane];
+    if (b && (b->pin() >= 0) && (digitalPinToInterrupt(b->pin()) == NOT_AN_INTERRUPT)) return false;
+  }
+
+  if (_slot < 0) {
+    for (int8_t n = 0; n < ONEBUTTONPINGROUP_GROUPS; n++) {
+      if (!_groups[n]) {
+        _slot = n;
+        break;
+      }
+    }
+    if (_slot < 0) return false;
+  }
+
+  _levels = _reader ? _reader() : _readPins();
+  _groups[_slot] = this;
+
+  for (uint8_t lane = 0; lane < ONEBUTTONPINGROUP_LANES; lane++) {
+    OneButton *b = _buttons[lane];
+    if (b && (b->pin() >= 0)) attachInterrupt(digitalPinToInterrupt(b->pin()), _handlers[_slot], CHANGE);
+  }
+  return true;
+}  // begin()
+
+
+void OneButtonPinGroup::end() {
+  if (_slot < 0) return;
+
+  for (uint8_t lane = 0; lane < ONEBUTTONPINGROUP_LANES; lane++) {
+    OneButton *b = _buttons[lane];
+    if (b && (b->pin() >= 0)) detachInterrupt(digitalPinToInterrupt(b->pin()));
+  }
+  _groups[_slot] = NULL;
+  _slot = -1;
+}  // end()
+
+
+void OneButtonPinGroup::reset(void) {
+  noInterrupts();
+  _levels = _reader ? _reader() : _readPins();
+  _dirty = 0;
+  interrupts();
+
+  _pending = _attached;
+  for (uint8_t lane = 0; lane < ONEBUTTONPINGROUP_LANES; lane++) {
+    if (_buttons[lane]) _buttons[lane]->reset();
+  }
+}  // reset()
+
+
+// read the active levels from the pins of the buttons.
+ONEBUTTON_ISR_ATTR uint32_t OneButtonPinGroup::_readPins(void) const {
+  uint32_t levels = 0;
+  uint32_t lanes = _attached;
+
+  while (lanes) {
+    uint8_t lane = __builtin_ctzl(lanes);
+    lanes &= lanes - 1;
+    if (_buttons[lane]->isPinActive()) levels |= ((uint32_t)1 << lane);
+  }
+  return levels;
+}  // _readPins()
+
+
+ONEBUTTON_ISR_ATTR void OneButtonPinGroup::isr(void) {
+  isr(_reader ? _reader() : _readPins());
+}  // isr()
+
+
+// mark the changed lanes.
+ONEBUTTON_ISR_ATTR void OneButtonPinGroup::isr(const uint32_t levels) {
+  _dirty |= (levels ^ _levels) & _attached;
+  _levels = levels;
+}  // isr()
+
+
+// get the earliest deadline of the pending buttons.
+bool OneButtonPinGroup::nextDeadlineMs(unsigned long &deadline) const {
+  bool found = false;
+  unsigned long ms;
+
+  if (_dirty) {
+    deadline = millis();
+    return true;
+  }
+
+  uint32_t lanes = _pending;
+  while (lanes) {
+    uint8_t lane = __builtin_ctzl(lanes);
+    lanes &= lanes - 1;
+    if (_buttons[lane]->nextDeadlineMs(ms) && (!found || ((long)(ms - deadline) < 0))) {
+      deadline = ms;
+      found = true;
+    }
+  }
+  return found;
+}  // nextDeadlineMs()
+
+
+/**
+ * @brief Advance the finite state machines (FSM) of the dirty and the pending buttons
+ * with the levels of the last interrupt.
+ */
+void OneButtonPinGroup::tick(void) {
+  noInterrupts();
+  uint32_t levels = _levels;
+  uint32_t lanes = _dirty | _pending;
+  _dirty = 0;
+  interrupts();
+
+  unsigned long now = millis();  // one time for all buttons.
+  while (lanes) {
+    uint8_t lane = __builtin_ctzl(lanes);
+    uint32_t bit = (uint32_t)1 << lane;
+    lanes &= lanes - 1;
+
+    OneButton *b = _buttons[lane];
+    bool level = (levels & bit) != 0;
+    b->tickAt(level, now);
+
+    // wait for the end of the timers and of debouncing.
+    if (b->isPending() || (b->debouncedValue() != level)) {
+      _pending |= bit;
+    } else {
+      _pending &= ~bit;
+    }
+  }
+}  // tick()
+
+
+// end.
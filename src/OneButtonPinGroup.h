@@ -0,0 +1,154 @@
+// -----
+// OneButtonPinGroup.h - Library for detecting button clicks, doubleclicks and
+// long press pattern on up to 32 buttons sharing one pin change interrupt
+// routine. This class is implemented for use with the Arduino environment.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// The interrupt routine of the group reads the levels of all lanes, compares
+// them with the levels of the last interrupt and marks the changed lanes as
+// dirty. This takes constant time when the levels are read by a reader
+// function from a port register. Without a reader the interrupt routine reads
+// the pin of every attached button on every level change of any of them, so
+// its time grows with the number of buttons: a digitalRead() takes about 4 usecs
+// on an Arduino UNO.
+// The tick() function in the main loop advances only the finite state
+// machines of the dirty buttons and of the buttons with pending timers or a
+// level that is not yet debounced.
+// -----
+
+#ifndef OneButtonPinGroup_h
+#define OneButtonPinGroup_h
+
+#include "Arduino.h"
+#include "OneButton.h"
+
+#define ONEBUTTONPINGROUP_LANES 32
+
+// The number of groups that can use the interrupt routines registered by begin().
+#define ONEBUTTONPINGROUP_GROUPS 4
+
+// Cores without NOT_AN_INTERRUPT have an interrupt on every pin.
+#ifndef NOT_AN_INTERRUPT
+#define NOT_AN_INTERRUPT -1
+#endif
+
+// Interrupt routines must be placed in RAM on the ESP boards.
+#if defined(ESP32)
+#define ONEBUTTON_ISR_ATTR IRAM_ATTR
+#elif defined(ESP8266)
+#define ONEBUTTON_ISR_ATTR ICACHE_RAM_ATTR
+#else
+#define ONEBUTTON_ISR_ATTR
+#endif
+
+
+class OneButtonPinGroup {
+public:
+  // A function returning the active levels of all lanes, e.g. from a port register.
+  typedef uint32_t (*readerFunction)(void);
+
+  // ----- Constructor -----
+
+  /**
+   * Create a OneButtonPinGroup instance without any buttons attached.
+   */
+  OneButtonPinGroup();
+
+  ~OneButtonPinGroup();
+
+  // ----- Set runtime parameters -----
+
+  /**
+   * Attach a OneButton instance to a lane of the group.
+   * The pin of the button is used by begin() and for reading the level without a reader function.
+   * @param lane The bit number 0...31 in the levels of the group.
+   * @param button The button to be used for this lane or NULL to detach a button.
+   */
+  void attach(const uint8_t lane, OneButton *button);
+
+  /**
+   * Set a function that reads the active levels of all lanes at once, e.g. from a port register.
+   * Without a reader the pins of all attached buttons are read in the interrupt routine,
+   * which takes one digitalRead() per attached button.
+   */
+  void setReader(readerFunction reader) {
+    _reader = reader;
+  };
+
+  // ----- Interrupt functions -----
+
+  /**
+   * Register the interrupt routine of the group for a level change on the pins of all attached buttons.
+   * Nothing is registered when a pin has no interrupt, the buttons can then be ticked one by one.
+   * @return false when all ONEBUTTONPINGROUP_GROUPS interrupt routines are in use or a pin has no interrupt.
+   */
+  bool begin();
+
+  /**
+   * Remove the interrupt routine from the pins.
+   */
+  void end();
+
+  /**
+   * Read the levels and mark the changed lanes, to be called from an interrupt routine.
+   * Takes constant time with a reader function and one digitalRead() per attached button without.
+   */
+  void isr(void);
+
+  /**
+   * Mark the lanes that changed since the last call, to be called from an interrupt routine.
+   * @param levels The active levels of all lanes.
+   */
+  void isr(const uint32_t levels);
+
+  // ----- State machine functions -----
+
+  /**
+   * @brief Advance the FSMs of the dirty buttons and the buttons with pending timers or debouncing.
+   * Call this function in the main loop.
+   */
+  void tick(void);
+
+  /**
+   * Reset the state machines of all buttons and read the levels again.
+   */
+  void reset(void);
+
+  /**
+   * @return The lanes that are advanced by the next tick().
+   */
+  uint32_t dueMask() const {
+    return _dirty | _pending;
+  };
+
+  /**
+   * @brief Get the earliest deadline of the buttons that are not dirty.
+   * @param deadline Set to the time in msecs as returned by millis().
+   * @return false when no timer is pending and only an interrupt can advance the FSMs.
+   */
+  bool nextDeadlineMs(unsigned long &deadline) const;
+
+private:
+  OneButton *_buttons[ONEBUTTONPINGROUP_LANES];
+  uint32_t _attached = 0;  // lanes with a button.
+  readerFunction _reader = NULL;
+  int8_t _slot = -1;  // index of the registered interrupt routine.
+
+  volatile uint32_t _levels = 0;  // active levels read by the last interrupt.
+  volatile uint32_t _dirty = 0;   // lanes changed since the last tick.
+  uint32_t _pending = 0;          // lanes with pending timers or debouncing.
+
+  uint32_t _readPins(void) const;
+
+  // the groups using the registered interrupt routines.
+  static OneButtonPinGroup *_groups[ONEBUTTONPINGROUP_GROUPS];
+  static void (*const _handlers[ONEBUTTONPINGROUP_GROUPS])(void);
+
+  template<int N>
+  static void _handler(void);
+};
+
+#endif
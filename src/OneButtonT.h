@@ -0,0 +1,2548 @@
+// -----
+// OneButtonT.h - Library for detecting button clicks, doubleclicks and long
+// press pattern on a single button. This class is implemented for use with the
+// Arduino environment. Copyright (c) by Matthias Hertel,
+// http://www.mathertel.de This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// The OneButtonT template implements the finite state machine (FSM) shared by
+// the OneButton and OneButtonTiny classes.
+// A configuration struct like OneButtonConfig (see OneButton.h) defines
+// * the supported events and whether parameterized callbacks are supported,
+// * the number of entries in the table of attached functions,
+// * the number of clicks waited for when no double or multi click function is attached,
+// * whether the event queue and the edge buffer can be used,
+// * whether statistics are collected,
+// * the debounce strategy,
+// * the clock used for all times,
+// * the transition table of the state machine,
+// * the type used for storing times and
+// * the default timing values.
+// Only the code and the state required by the configured features is compiled.
+// -----
+
+#ifndef OneButtonT_h
+#define OneButtonT_h
+
+#include "Arduino.h"
+
+// The transition tables are stored in the flash memory on AVR.
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#define ONEBUTTON_PROGMEM PROGMEM
+#define ONEBUTTON_READ_BYTE(p) pgm_read_byte(p)
+#else
+#define ONEBUTTON_PROGMEM
+#define ONEBUTTON_READ_BYTE(p) (*(const uint8_t *)(p))
+#endif
+
+// ----- Callback function types -----
+
+extern "C" {
+  typedef void (*callbackFunction)(void);
+  typedef void (*parameterizedCallbackFunction)(void *);
+}
+
+class OneButtonEventQueue;
+class OneButtonBase;
+
+// The number of gaps between the clicks kept in the event record.
+#ifndef ONEBUTTONEVENT_GAPS
+#define ONEBUTTONEVENT_GAPS 3
+#endif
+
+/**
+ * A compact record of a detected event.
+ */
+struct OneButtonEvent {
+  OneButtonBase *button;                        // the button that detected the event.
+  void (*dispatcher)(const OneButtonEvent &e);  // calls the functions attached to the button.
+  uint8_t event;                                // the type of the event, see OneButtonBase::event_t.
+  uint8_t clicks;                               // number of clicks.
+  uint8_t repeats;                              // number of coalesced auto repeats for DuringLongPress.
+  uint16_t gaps[ONEBUTTONEVENT_GAPS];           // msecs between a release and the next press, gaps[0] before the 2nd click.
+  unsigned long duration;                       // msecs the button is pressed for long press and click events.
+  unsigned long time;                           // time of the clock when the event was detected.
+};
+
+// A function receiving the record of an event.
+typedef void (*eventHandlerFunction)(const OneButtonEvent &e);
+
+/**
+ * A level change of the input captured with its time, e.g. in a pin change interrupt.
+ */
+struct OneButtonEdge {
+  unsigned long time;  // time of the clock when the level has changed.
+  bool level;          // the new active level.
+};
+
+
+/**
+ * The part of all OneButtonT classes that does not depend on the configuration.
+ */
+class OneButtonBase {
+public:
+  /**
+   * The events that are detected by the state machine.
+   */
+  enum event_t : uint8_t {
+    EV_PRESS = 0,
+    EV_CLICK = 1,
+    EV_DOUBLECLICK = 2,
+    EV_MULTICLICK = 3,
+    EV_LONGPRESSSTART = 4,
+    EV_DURINGLONGPRESS = 5,
+    EV_LONGPRESSSTOP = 6,
+    EV_IDLE = 7,
+    EV_TENTATIVECLICK = 8,   // a click that may become part of a double or multi click.
+    EV_CLICKSUPERSEDED = 9,  // the tentative click is not a single click.
+  };
+
+  // define FiniteStateMachine
+  enum stateMachine_t : uint8_t {
+    OCS_INIT = 0,
+    OCS_DOWN = 1,   // button is down
+    OCS_UP = 2,     // button is up
+    OCS_COUNT = 3,  // in multi press-mode, counting
+    OCS_PRESS = 6,  // button is hold down
+    OCS_PRESSEND = 7,
+  };
+
+  /**
+   * @return true if we are currently handling button press flow
+   * (This allows power sensitive applications to know when it is safe to power down the main CPU)
+   */
+  bool isIdle() const {
+    return _state == OCS_INIT;
+  }
+
+  /**
+   * @return true when a long press is detected
+   */
+  bool isLongPressed() const {
+    return _state == OCS_PRESS;
+  };
+
+  /**
+   * @return The hardware pin number or -1 when no pin is used.
+   */
+  int pin() const {
+    return _hasPin() ? _pin : -1;
+  };
+
+  /**
+   * @return true when the pin is at the level of a pressed button, read without debouncing.
+   */
+  bool isPinActive() const {
+    return _hasPin() && (digitalRead(_pin) == _buttonPressed);
+  };
+
+  stateMachine_t state() const {
+    return _state;
+  };
+
+protected:
+  OneButtonBase()
+    : _buttonPressed(LOW), _idleState(false){};
+
+  // The members are packed into 5 bytes, the flags are bitfields.
+  uint8_t _pin = 0xFF;  // hardware pin number, 0xFF when no pin is used.
+
+  stateMachine_t _state = OCS_INIT;
+
+  uint8_t _nClicks = 0;    // count the number of clicks with this variable
+  uint8_t _maxClicks = 1;  // max number (1, 2, multi=100) of clicks of interest by registration of event functions.
+
+  uint8_t _buttonPressed : 1;  // this is the level of the input pin when the button is pressed.
+                               // LOW if the button connects the input pin to GND when pressed.
+                               // HIGH if the button connects the input pin to VCC when pressed.
+  uint8_t _idleState : 1;      // the idle event was fired since the end of the last sequence.
+
+  bool _hasPin() const {
+    return _pin != 0xFF;
+  };
+
+  /**
+   * Add an event to a queue, implemented in OneButtonEventQueue.cpp.
+   */
+  static bool _pushEvent(OneButtonEventQueue *queue, const OneButtonEvent &e);
+};
+
+
+/**
+ * Counters for analyzing the behavior of a button, available when enabled in the configuration.
+ */
+struct OneButtonStats {
+  unsigned long ticks;            // calls of tick(), tick(bool) and tickDebounced().
+  unsigned long maxTickGapMs;     // longest time between 2 ticks.
+  unsigned long bounces;          // level changes rejected by debouncing.
+  unsigned long transitions[8];   // transitions into the states, indexed by OneButtonBase::stateMachine_t.
+  unsigned long events[10];       // detected events, indexed by OneButtonBase::event_t.
+  unsigned long callbacks;        // calls of attached functions.
+  unsigned long callbackMaxUs;    // longest time spent in an attached function.
+  unsigned long callbackTotalUs;  // total time spent in attached functions.
+};
+
+
+// ----- Transition table -----
+
+/**
+ * A transition of the state machine: the next state and the action taken.
+ */
+struct OneButtonTransition {
+  uint8_t next;
+  uint8_t action;
+};
+
+/**
+ * A row of the transition table: the timer of the state and the transitions
+ * for the 4 input classes given by the active level (bit 0) and the expired timer (bit 1).
+ */
+struct OneButtonFsmState {
+  uint8_t timer;
+  OneButtonTransition on[4];
+};
+
+/**
+ * The transition table of the OneButton and OneButtonTiny state machines.
+ * A configuration can use another table with more states by setting fsm_type to a
+ * class derived from OneButtonFsm. The actions and timers from ACT_USER and TIMER_USER
+ * on are implemented by its action(), timeout() and deadline() functions that have
+ * access to the button internals.
+ */
+struct OneButtonFsm {
+  enum timer_t : uint8_t {
+    TIMER_NONE = 0,
+    TIMER_IDLE = 1,    // idle time since the last sequence when the idle function is attached.
+    TIMER_PRESS = 2,   // press time since the button went down.
+    TIMER_CLICK = 3,   // click time since the button went up or the maximum number of clicks.
+    TIMER_DURING = 4,  // interval of the during long press events.
+    TIMER_USER = 8,
+  };
+
+  enum action_t : uint8_t {
+    ACT_NONE = 0,
+    ACT_PRESS = 1,        // start a sequence: EV_PRESS.
+    ACT_IDLE = 2,         // EV_IDLE once.
+    ACT_IDLE_PRESS = 3,   // EV_IDLE and the start of a sequence in the same tick.
+    ACT_RELEASE = 4,      // count a click: EV_TENTATIVECLICK for the first one.
+    ACT_REPRESS = 5,      // the next press of a sequence: EV_CLICKSUPERSEDED for the first one.
+    ACT_CLICKS = 6,       // EV_CLICK, EV_DOUBLECLICK or EV_MULTICLICK and end of the sequence.
+    ACT_LONGSTART = 7,    // EV_LONGPRESSSTART.
+    ACT_DURING = 8,       // EV_DURINGLONGPRESS.
+    ACT_LONGSTOP = 9,     // EV_LONGPRESSSTOP and end of the sequence.
+    ACT_RESTART = 10,     // end of the sequence without an event.
+    ACT_USER = 16,
+  };
+
+  static constexpr uint8_t stateCount = 8;
+
+  /**
+   * @return The transition table with stateCount rows indexed by the state.
+   * The states UP and PRESSEND are never entered, their transitions are taken
+   * in the same tick like DOWN to COUNT by ACT_RELEASE.
+   */
+  static const OneButtonFsmState *states() {
+    enum : uint8_t {
+      INIT = OneButtonBase::OCS_INIT,
+      DOWN = OneButtonBase::OCS_DOWN,
+      COUNT = OneButtonBase::OCS_COUNT,
+      PRESS = OneButtonBase::OCS_PRESS,
+    };
+    static const OneButtonFsmState table[stateCount] ONEBUTTON_PROGMEM = {
+      // timer, transitions when released, pressed, released + timer expired, pressed + timer expired
+      { TIMER_IDLE, { { INIT, ACT_NONE }, { DOWN, ACT_PRESS }, { INIT, ACT_IDLE }, { DOWN, ACT_IDLE_PRESS } } },          // OCS_INIT
+      { TIMER_PRESS, { { COUNT, ACT_RELEASE }, { DOWN, ACT_NONE }, { COUNT, ACT_RELEASE }, { PRESS, ACT_LONGSTART } } },  // OCS_DOWN
+      { TIMER_NONE, { { COUNT, ACT_RELEASE }, { COUNT, ACT_RELEASE }, { COUNT, ACT_RELEASE }, { COUNT, ACT_RELEASE } } },  // OCS_UP
+      { TIMER_CLICK, { { COUNT, ACT_NONE }, { DOWN, ACT_REPRESS }, { INIT, ACT_CLICKS }, { DOWN, ACT_REPRESS } } },        // OCS_COUNT
+      { TIMER_NONE, { { INIT, ACT_RESTART }, { INIT, ACT_RESTART }, { INIT, ACT_RESTART }, { INIT, ACT_RESTART } } },      // unused
+      { TIMER_NONE, { { INIT, ACT_RESTART }, { INIT, ACT_RESTART }, { INIT, ACT_RESTART }, { INIT, ACT_RESTART } } },      // unused
+      { TIMER_DURING, { { INIT, ACT_LONGSTOP }, { PRESS, ACT_NONE }, { INIT, ACT_LONGSTOP }, { PRESS, ACT_DURING } } },    // OCS_PRESS
+      { TIMER_NONE, { { INIT, ACT_LONGSTOP }, { INIT, ACT_LONGSTOP }, { INIT, ACT_LONGSTOP }, { INIT, ACT_LONGSTOP } } },  // OCS_PRESSEND
+    };
+    return table;
+  };
+
+  /**
+   * @return true when a timer from TIMER_USER on has expired.
+   */
+  template<class BUTTON>
+  static bool timeout(BUTTON &, const uint8_t) {
+    return false;
+  };
+
+  /**
+   * @brief Get the time when a timer from TIMER_USER on expires.
+   * @return false when the timer is not running.
+   */
+  template<class BUTTON>
+  static bool deadline(const BUTTON &, const uint8_t, typename BUTTON::time_type &) {
+    return false;
+  };
+
+  /**
+   * Run an action from ACT_USER on, including the change to the next state.
+   */
+  template<class BUTTON>
+  static void action(BUTTON &, const uint8_t, const uint8_t) {};
+};
+
+
+// ----- Clocks -----
+
+/**
+ * The clock of the OneButton and OneButtonTiny classes using millis().
+ * A clock provides the current time by now() and the number of its units per msec
+ * so the timing values given in msecs can be converted.
+ */
+struct OneButtonClockMillis {
+  static constexpr unsigned long ticksPerMs = 1;
+  static unsigned long now() {
+    return millis();
+  };
+};
+
+/**
+ * A clock using micros() for sub-millisecond debouncing of fast signal inputs.
+ * A time_type of 32 bits wraps after about 71 minutes which is handled like the wrap of millis().
+ */
+struct OneButtonClockMicros {
+  static constexpr unsigned long ticksPerMs = 1000;
+  static unsigned long now() {
+    return micros();
+  };
+};
+
+/**
+ * A monotonic 64-bit clock in msecs extending millis() by counting its wraps.
+ * It must be used with a 64-bit time_type and read at least once every 49 days,
+ * from one task only.
+ */
+struct OneButtonClockMillis64 {
+  static constexpr unsigned long ticksPerMs = 1;
+  static uint64_t now() {
+    static uint32_t high = 0;
+    static uint32_t last = 0;
+    uint32_t ms = millis();
+    if (ms < last) high++;
+    last = ms;
+    return ((uint64_t)high << 32) | ms;
+  };
+};
+
+
+// ----- Debounce strategies -----
+// The time of the last level change may be stored in a shorter type STORE than
+// the time of the clock as it is only compared within the debounce window.
+
+/**
+ * Debouncing by time: a new level is taken over when it is stable for the debounce time.
+ * A negative debounce time only debounces going into the inactive level.
+ */
+template<class TIME, class STORE = TIME>
+class OneButtonDebounceTime {
+public:
+  OneButtonDebounceTime()
+    : _level(false), _lastLevel(false){};
+
+  /**
+   * Debounce the level at the given time.
+   * @return The debounced level.
+   */
+  bool debounce(const bool value, const TIME now, const int ms) {
+    // Don't debounce going into active state, if ms is negative
+    // Don't debounce at all if ms is 0
+    if (ms == 0 || (value && ms < 0))
+      _level = value;
+
+    if (_lastLevel == value) {
+      if ((STORE)((STORE)now - _lastTime) >= (STORE)abs(ms))
+        _level = value;
+    } else {
+      _lastTime = (STORE)now;
+      _lastLevel = value;
+    }
+    return _level;
+  };
+
+  /**
+   * @return true when the value aborts a level change that is not stable yet.
+   */
+  bool rejects(const bool value) const {
+    return (_lastLevel != _level) && (_lastLevel != value);
+  };
+
+  /**
+   * Take over a level that was debounced by the caller.
+   */
+  void set(const bool value) {
+    _level = _lastLevel = value;
+  };
+
+  bool level() const {
+    return _level;
+  };
+
+  /**
+   * @return true when a new level is waiting to become stable at the time given in t.
+   * @param now The time of the last call of debounce().
+   */
+  bool deadline(TIME &t, const int ms, const TIME now) const {
+    if (_lastLevel == _level) return false;
+    t = now - (STORE)((STORE)now - _lastTime) + abs(ms);
+    return true;
+  };
+
+  /**
+   * @return The debounce window in msecs.
+   */
+  TIME window(const int ms) const {
+    return (TIME)abs(ms);
+  };
+
+private:
+  bool _level : 1;
+  bool _lastLevel : 1;  // used for pin debouncing
+  STORE _lastTime = 0;  // time of the last level change.
+};
+
+
+/**
+ * Debouncing by time with an optional window that is learned from the observed bounce bursts.
+ * A burst lasts from the first to the last level change before the level is stable.
+ * The estimate of the burst length follows longer bursts at once and shorter bursts slowly.
+ * The window is the estimate plus a safety margin of 50% and 1 msec within the given bounds
+ * so it is longer than any gap between the level changes of the bursts seen so far.
+ * Without adaptive mode it works like OneButtonDebounceTime.
+ */
+template<class TIME, class STORE = TIME>
+class OneButtonDebounceAdaptive {
+public:
+  OneButtonDebounceAdaptive()
+    : _level(false), _lastLevel(false), _inBurst(false){};
+
+  /**
+   * Debounce the level at the given time.
+   * @return The debounced level.
+   */
+  bool debounce(const bool value, const TIME now, const int ms) {
+    const TIME window = this->window(ms);
+
+    // Don't debounce going into active state, if ms is negative
+    // Don't debounce at all if ms is 0
+    if (ms == 0 || (value && ms < 0))
+      _accept(value);
+
+    const STORE elapsed = (STORE)((STORE)now - _lastTime);
+
+    if (_lastLevel == value) {
+      if (elapsed >= (STORE)window)
+        _accept(value);
+    } else {
+      if (!_inBurst) {
+        // the first change after a stable level.
+        _burst = 0;
+        _inBurst = true;
+      } else {
+        _burst = (elapsed < (STORE)(255 - _burst)) ? (uint8_t)(_burst + elapsed) : 255;
+      }
+      _lastTime = (STORE)now;
+      _lastLevel = value;
+    }
+    return _level;
+  };
+
+  bool rejects(const bool value) const {
+    return (_lastLevel != _level) && (_lastLevel != value);
+  };
+
+  void set(const bool value) {
+    _level = _lastLevel = value;
+  };
+
+  bool level() const {
+    return _level;
+  };
+
+  bool deadline(TIME &t, const int ms, const TIME now) const {
+    if (_lastLevel == _level) return false;
+    t = now - (STORE)((STORE)now - _lastTime) + window(ms);
+    return true;
+  };
+
+  /**
+   * Enable the adaptive mode using a window between minMs and maxMs.
+   * The estimate starts with the maximum to avoid double counts while learning.
+   * Passing a maxMs of 0 disables the adaptive mode.
+   */
+  void setAdaptive(const uint8_t minMs, const uint8_t maxMs) {
+    _minMs = min(minMs, maxMs);
+    _maxMs = maxMs;
+    _estimate16 = (uint16_t)maxMs << 4;
+  };
+
+  /**
+   * @return The debounce window in msecs.
+   */
+  TIME window(const int ms) const {
+    if (!_maxMs) return (TIME)abs(ms);
+    unsigned int est = _estimate16 >> 4;
+    return (TIME)constrain(est + (est >> 1) + 1, (unsigned int)_minMs, (unsigned int)_maxMs);
+  };
+
+  /**
+   * @return The estimated length of the bounce bursts in msecs.
+   */
+  unsigned int bounceMs() const {
+    return _estimate16 >> 4;
+  };
+
+  /**
+   * Set the estimated length of the bounce bursts, e.g. a value learned before.
+   */
+  void setBounceMs(const unsigned int ms) {
+    _estimate16 = min(ms, 0x0FFFu) << 4;
+  };
+
+private:
+  bool _level : 1;
+  bool _lastLevel : 1;  // used for pin debouncing
+  bool _inBurst : 1;    // level changes since the last stable level.
+  uint8_t _minMs = 0;   // window bounds in adaptive mode, 0 = adaptive mode off.
+  uint8_t _maxMs = 0;
+  uint8_t _burst = 0;        // time from the first to the last change of the burst, up to 255.
+  uint16_t _estimate16 = 0;  // estimated burst length in 1/16 msecs.
+  STORE _lastTime = 0;       // time of the last level change.
+
+  // a burst ends when the level is stable. A glitch settling back to
+  // the debounced level ends the burst without learning from it.
+  void _accept(const bool value) {
+    if (_inBurst) {
+      if (_maxMs && (_level != value)) _learn(_burst);
+      _inBurst = false;
+    }
+    _level = value;
+  };
+
+  // longer bursts are taken over at once up to the maximum,
+  // shorter bursts reduce the estimate by 1/8 of the difference.
+  void _learn(const uint8_t burst) {
+    uint16_t b16 = (uint16_t)min(_maxMs, burst) << 4;
+    if (b16 > _estimate16) {
+      _estimate16 = b16;
+    } else {
+      _estimate16 -= (_estimate16 - b16) >> 3;
+    }
+  };
+};
+
+
+/**
+ * No debouncing for inputs that are debounced by hardware or by the caller.
+ */
+template<class TIME, class STORE = TIME>
+class OneButtonDebounceNone {
+public:
+  bool debounce(const bool value, const TIME, const int) {
+    _level = value;
+    return _level;
+  };
+
+  bool rejects(const bool) const {
+    return false;
+  };
+
+  void set(const bool value) {
+    _level = value;
+  };
+
+  bool level() const {
+    return _level;
+  };
+
+  bool deadline(TIME &, const int, const TIME) const {
+    return false;
+  };
+
+  TIME window(const int) const {
+    return 0;
+  };
+
+private:
+  bool _level = false;
+};
+
+
+// ----- Optional state of OneButtonT -----
+
+// A feature that is not configured uses static members with the same names.
+// This keeps the code compiling while the instances do not carry the state.
+// The code using these members is removed by the compiler as the configuration is constant.
+
+template<class Config, bool ENABLED>
+struct OneButtonIdleState {
+  unsigned int _idle_ms = Config::idleMs;  // number of msecs before idle is detected, may be longer than a minute.
+};
+
+template<class Config>
+struct OneButtonIdleState<Config, false> {
+  static unsigned int _idle_ms;
+};
+template<class Config> unsigned int OneButtonIdleState<Config, false>::_idle_ms = 0;
+
+
+template<class Config, bool ENABLED>
+struct OneButtonDuringLongPressState {
+  typedef typename Config::time_type time_type;
+  time_type _nextDuringTime = 0;         // time of the next DuringLongPress event.
+  uint16_t _long_press_interval_ms = 0;  // interval in msecs between calls of the DuringLongPress event
+  uint16_t _repeat_delay_ms = 0;         // msecs from the long press start to the first auto repeat.
+  uint16_t _repeat_ms = 0;               // first interval of the auto repeat, 0 when not used.
+  uint16_t _repeat_min_ms = 0;           // shortest interval of the auto repeat.
+  uint16_t _repeat_ramp_ms = 0;          // msecs to accelerate from the first to the shortest interval.
+  uint16_t _repeatElapsedMs = 0;         // msecs from the first auto repeat to the next one, up to the ramp.
+  uint8_t _repeatCount = 0;              // repeats coalesced into the current DuringLongPress event.
+};
+
+template<class Config>
+struct OneButtonDuringLongPressState<Config, false> {
+  typedef typename Config::time_type time_type;
+  static time_type _nextDuringTime;
+  static uint16_t _long_press_interval_ms, _repeat_delay_ms, _repeat_ms, _repeat_min_ms, _repeat_ramp_ms, _repeatElapsedMs;
+  static uint8_t _repeatCount;
+};
+template<class Config> typename Config::time_type OneButtonDuringLongPressState<Config, false>::_nextDuringTime = 0;
+template<class Config> uint16_t OneButtonDuringLongPressState<Config, false>::_long_press_interval_ms = 0;
+template<class Config> uint16_t OneButtonDuringLongPressState<Config, false>::_repeat_delay_ms = 0;
+template<class Config> uint16_t OneButtonDuringLongPressState<Config, false>::_repeat_ms = 0;
+template<class Config> uint16_t OneButtonDuringLongPressState<Config, false>::_repeat_min_ms = 0;
+template<class Config> uint16_t OneButtonDuringLongPressState<Config, false>::_repeat_ramp_ms = 0;
+template<class Config> uint16_t OneButtonDuringLongPressState<Config, false>::_repeatElapsedMs = 0;
+template<class Config> uint8_t OneButtonDuringLongPressState<Config, false>::_repeatCount = 0;
+
+
+template<class Config, bool ENABLED>
+struct OneButtonQueueState {
+  OneButtonEventQueue *_eventQueue = NULL;      // queue for the events, NULL to call the functions directly.
+  const OneButtonEvent *_dispatchEvent = NULL;  // event currently dispatched from the queue.
+};
+
+template<class Config>
+struct OneButtonQueueState<Config, false> {
+  static OneButtonEventQueue *_eventQueue;
+  static const OneButtonEvent *_dispatchEvent;
+};
+template<class Config> OneButtonEventQueue *OneButtonQueueState<Config, false>::_eventQueue = NULL;
+template<class Config> const OneButtonEvent *OneButtonQueueState<Config, false>::_dispatchEvent = NULL;
+
+
+template<class Config, bool ENABLED>
+struct OneButtonPayloadState {
+  typedef typename Config::time_type time_type;
+  time_type _pressTime = 0;     // time of the last press.
+  uint16_t _eventFuncMask = 0;  // events with a function receiving the event record.
+  uint16_t _gapsMs[ONEBUTTONEVENT_GAPS] = {};  // gaps between the clicks of the sequence.
+};
+
+template<class Config>
+struct OneButtonPayloadState<Config, false> {
+  typedef typename Config::time_type time_type;
+  static uint16_t _eventFuncMask;
+  static time_type _pressTime;
+  static uint16_t _gapsMs[ONEBUTTONEVENT_GAPS];
+};
+template<class Config> uint16_t OneButtonPayloadState<Config, false>::_eventFuncMask = 0;
+template<class Config> typename Config::time_type OneButtonPayloadState<Config, false>::_pressTime = 0;
+template<class Config> uint16_t OneButtonPayloadState<Config, false>::_gapsMs[ONEBUTTONEVENT_GAPS] = {};
+
+
+template<class Config, bool ENABLED>
+struct OneButtonEdgeState {
+  typedef typename Config::time_type time_type;
+  OneButtonEdge *_edges = NULL;  // buffer for captured edges, NULL when reading the pin.
+  uint8_t _edgeMask = 0;         // size - 1 used to wrap the indices.
+  uint8_t _edgeHead = 0;         // written by addEdge() only.
+  uint8_t _edgeTail = 0;         // written by tick() only.
+  uint8_t _edgeDrops = 0;        // number of dropped edges, written by addEdge() only.
+  uint8_t _edgeDropsSeen = 0;    // number of dropped edges handled by tick().
+  bool _edgeLevel = false;       // level of the last replayed edge.
+  time_type _edgeTime = 0;       // time of the last replayed edge.
+};
+
+template<class Config>
+struct OneButtonEdgeState<Config, false> {
+  typedef typename Config::time_type time_type;
+  static OneButtonEdge *_edges;
+  static uint8_t _edgeMask, _edgeHead, _edgeTail, _edgeDrops, _edgeDropsSeen;
+  static bool _edgeLevel;
+  static time_type _edgeTime;
+};
+template<class Config> OneButtonEdge *OneButtonEdgeState<Config, false>::_edges = NULL;
+template<class Config> uint8_t OneButtonEdgeState<Config, false>::_edgeMask = 0;
+template<class Config> uint8_t OneButtonEdgeState<Config, false>::_edgeHead = 0;
+template<class Config> uint8_t OneButtonEdgeState<Config, false>::_edgeTail = 0;
+template<class Config> uint8_t OneButtonEdgeState<Config, false>::_edgeDrops = 0;
+template<class Config> uint8_t OneButtonEdgeState<Config, false>::_edgeDropsSeen = 0;
+template<class Config> bool OneButtonEdgeState<Config, false>::_edgeLevel = false;
+template<class Config> typename Config::time_type OneButtonEdgeState<Config, false>::_edgeTime = 0;
+
+
+template<class Config, bool ENABLED>
+struct OneButtonStatsState {
+  typedef typename Config::time_type time_type;
+  OneButtonStats _stats = OneButtonStats();  // the counters.
+  time_type _lastTickTime = 0;              // time of the last tick.
+};
+
+template<class Config>
+struct OneButtonStatsState<Config, false> {
+  typedef typename Config::time_type time_type;
+  static OneButtonStats _stats;
+  static time_type _lastTickTime;
+};
+template<class Config> OneButtonStats OneButtonStatsState<Config, false>::_stats = OneButtonStats();
+template<class Config> typename Config::time_type OneButtonStatsState<Config, false>::_lastTickTime = 0;
+
+
+// An entry in the table of attached functions.
+// It holds a callbackFunction or a parameterizedCallbackFunction with its parameter.
+// A function object like a lambda is stored by OneButtonCallable as a parameterizedCallbackFunction
+// with the captures in the parameter.
+// Without parameterized callbacks an entry only takes the size of a function pointer.
+template<bool PARAM, class DUMMY = void>
+struct OneButtonHandler {
+  union {
+    callbackFunction func;
+    parameterizedCallbackFunction paramFunc;
+    eventHandlerFunction eventFunc;
+  };
+  void *param;
+};
+
+template<class DUMMY>
+struct OneButtonHandler<false, DUMMY> {
+  union {
+    callbackFunction func;
+    parameterizedCallbackFunction paramFunc;
+    eventHandlerFunction eventFunc;
+  };
+  static void *param;
+};
+template<class DUMMY> void *OneButtonHandler<false, DUMMY>::param = NULL;
+
+
+// A type that exists only when the condition is true.
+template<bool B, class T = void>
+struct OneButtonEnableIf {};
+
+template<class T>
+struct OneButtonEnableIf<true, T> {
+  typedef T type;
+};
+
+// The type T when the condition is true, otherwise F.
+template<bool B, class T, class F>
+struct OneButtonIf {
+  typedef T type;
+};
+
+template<class T, class F>
+struct OneButtonIf<false, T, F> {
+  typedef F type;
+};
+
+
+/**
+ * A function object like a lambda stored without heap in the parameter of a handler entry.
+ * The captures must fit into one pointer like [this] or [&counter] and be trivially copyable.
+ * The function object is called by one indirect call of invoke().
+ * Function objects without captures are converted to a callbackFunction or an eventHandlerFunction instead.
+ */
+template<class F>
+struct OneButtonCallable {
+  template<class T>
+  static char _hasCall(decltype(&T::operator()));
+  template<class T>
+  static long _hasCall(...);
+
+  static char _isFunction(callbackFunction);
+  static char _isFunction(eventHandlerFunction);
+  static char _isFunction(decltype(nullptr));  // nullptr is not a function object.
+  static long _isFunction(...);
+  static const F &_object();
+
+  // a function object that is not converted to a function pointer.
+  static constexpr bool capturing = (sizeof(_hasCall<F>(0)) == 1) && (sizeof(_isFunction(_object())) != 1);
+
+  static void invoke(void *param) {
+    alignas(F) unsigned char buffer[sizeof(F)];
+    __builtin_memcpy(buffer, &param, sizeof(F));
+    (*reinterpret_cast<F *>(buffer))();
+  };
+
+  static void *pack(const F &f) {
+    static_assert(sizeof(F) <= sizeof(void *), "The captures of the function object must fit into one pointer, capture this or a pointer to a struct.");
+    static_assert(__is_trivially_copyable(F), "The captures of the function object must be trivially copyable.");
+    void *param = NULL;
+    __builtin_memcpy(&param, &f, sizeof(F));
+    return param;
+  };
+};
+
+// Enables the attach functions for function objects with captures.
+template<class F>
+using OneButtonIfCapturing = typename OneButtonEnableIf<OneButtonCallable<F>::capturing>::type;
+
+// The types of the null pointer constants NULL, 0 and nullptr.
+template<class T>
+struct OneButtonIsNull {
+  static constexpr bool value = false;
+};
+template<>
+struct OneButtonIsNull<int> {
+  static constexpr bool value = true;
+};
+template<>
+struct OneButtonIsNull<long> {
+  static constexpr bool value = true;
+};
+template<>
+struct OneButtonIsNull<decltype(nullptr)> {
+  static constexpr bool value = true;
+};
+
+// Enables the attach functions for NULL, 0 and nullptr removing the function of an event.
+// They match exactly and take precedence over the conversions to the function pointer types.
+template<class T>
+using OneButtonIfNull = typename OneButtonEnableIf<OneButtonIsNull<T>::value>::type;
+
+
+// ----- The button class -----
+
+template<class Config>
+class OneButtonT : public OneButtonBase,
+                   private OneButtonIdleState<Config, (Config::events & (1 << OneButtonBase::EV_IDLE)) != 0>,
+                   private OneButtonDuringLongPressState<Config, (Config::events & (1 << OneButtonBase::EV_DURINGLONGPRESS)) != 0>,
+                   private OneButtonQueueState<Config, Config::eventQueue>,
+                   private OneButtonPayloadState<Config, Config::eventPayload>,
+                   private OneButtonEdgeState<Config, Config::edgeBuffer>,
+                   private OneButtonStatsState<Config, Config::stats> {
+  // the transition table may implement its own actions and timers.
+  friend typename Config::fsm_type;
+
+public:
+  typedef typename Config::time_type time_type;
+  typedef typename Config::clock_type clock_type;
+
+  // ----- Constructor -----
+
+  /*
+   * Create a OneButton instance.
+   * use setup(...) to specify the hardware configuration.
+   */
+  OneButtonT() {
+    _maxClicks = Config::maxClicks;
+  };
+
+  /**
+   * Create a OneButton instance and setup.
+   * @param pin The pin to be used for input from a momentary button.
+   * @param activeLow Set to true when the input level is LOW when the button is pressed, Default is true.
+   * @param pullupActive Activate the internal pullup when available. Default is true.
+   */
+  explicit OneButtonT(const int pin, const bool activeLow = true, const bool pullupActive = true) {
+    _maxClicks = Config::maxClicks;
+    setup(pin, pullupActive ? INPUT_PULLUP : INPUT, activeLow);
+  };
+
+  // ----- Set runtime parameters -----
+
+
+  /**
+   * Initialize or re-initialize the input pin.
+   * @param pin The pin to be used for input from a momentary button.
+   * @param mode Any of the modes also used in pinMode like INPUT or INPUT_PULLUP (default).
+   * @param activeLow Set to true when the input level is LOW when the button is pressed, Default is true.
+   */
+  void setup(const uint8_t pin, const uint8_t mode = INPUT_PULLUP, const bool activeLow = true);
+
+
+  /**
+   * set # millisec after safe click is assumed.
+   */
+  [[deprecated("Use setDebounceMs() instead.")]]
+  void setDebounceTicks(const unsigned int ms) {
+    setDebounceMs(ms);
+  };  // deprecated
+  void setDebounceMs(const int ms) {
+    _debounce_time = (span_type)(ms * (int)clock_type::ticksPerMs);
+  };
+
+  /**
+   * set # microsec after safe click is assumed, rounded up to the units of the clock.
+   * This allows debouncing below 1 msec by using a clock like OneButtonClockMicros.
+   */
+  void setDebounceUs(const long us) {
+    const long t = us * (long)clock_type::ticksPerMs;
+    _debounce_time = (span_type)((t + ((us < 0) ? -999 : 999)) / 1000);
+  };
+
+  /**
+   * Learn the debounce time from the observed bounces of the button within the given bounds.
+   * Good switches get a shorter press latency, worn switches a longer debounce time.
+   * The sign of the debounce msecs is kept. Passing maxMs = 0 uses the fixed debounce msecs again.
+   * Requires the OneButtonDebounceAdaptive strategy as used by OneButton and a clock in msecs
+   * as the bounds and the learned bursts are kept in msecs of up to 255.
+   */
+  template<bool MS = (clock_type::ticksPerMs == 1)>
+  void setAdaptiveDebounce(const uint8_t minMs, const uint8_t maxMs) {
+    static_assert(MS, "The adaptive debouncing requires a clock in msecs.");
+    _debouncer.setAdaptive(minMs, maxMs);
+  };
+
+  /**
+   * @return The debounce time in msecs currently used, the learned value in adaptive mode.
+   */
+  unsigned int getDebounceMs() const {
+    return _debouncer.window(_debounce_time) / clock_type::ticksPerMs;
+  };
+
+  /**
+   * @return The learned length of the bounce bursts in msecs that can be persisted.
+   */
+  template<bool MS = (clock_type::ticksPerMs == 1)>
+  unsigned int getBounceMs() const {
+    static_assert(MS, "The adaptive debouncing requires a clock in msecs.");
+    return _debouncer.bounceMs();
+  };
+
+  /**
+   * Restore a learned length of the bounce bursts, e.g. after a restart.
+   */
+  template<bool MS = (clock_type::ticksPerMs == 1)>
+  void setBounceMs(const unsigned int ms) {
+    static_assert(MS, "The adaptive debouncing requires a clock in msecs.");
+    _debouncer.setBounceMs(ms);
+  };
+
+  /**
+   * set # millisec after single click is assumed.
+   */
+  [[deprecated("Use setClickMs() instead.")]]
+  void setClickTicks(const unsigned int ms) {
+    setClickMs(ms);
+  };  // deprecated
+  void setClickMs(const unsigned int ms) {
+    _click_ms = _ms16(ms);
+  };
+
+  /**
+   * set # millisec after press is assumed.
+   */
+  [[deprecated("Use setPressMs() instead.")]]
+  void setPressTicks(const unsigned int ms) {
+    setPressMs(ms);
+  };  // deprecated
+  void setPressMs(const unsigned int ms) {
+    _press_ms = _ms16(ms);
+  };
+
+  /**
+   * set interval in msecs between calls of the DuringLongPress event.
+   * 0 ms is the fastest events calls.
+   */
+  void setLongPressIntervalMs(const unsigned int ms) {
+    static_assert(_hasEvent(EV_DURINGLONGPRESS), "The DuringLongPress event is not supported by this configuration.");
+    this->_long_press_interval_ms = _ms16(ms);
+  };
+
+  /**
+   * Use the DuringLongPress event as an accelerating auto repeat like the typematic keys of a keyboard.
+   * The interval shrinks linearly from intervalMs to minIntervalMs within rampMs.
+   * When tick() is called late the repeats that are due meanwhile are reported by one event,
+   * see getRepeatCount().
+   * @param delayMs The msecs from the long press start to the first repeat.
+   * @param intervalMs The first interval between repeats or 0 to use setLongPressIntervalMs() again.
+   * @param minIntervalMs The shortest interval, 0 for no acceleration.
+   * @param rampMs The msecs from the first repeat until the shortest interval is reached, 0 for no acceleration.
+   */
+  void setAutoRepeat(const unsigned int delayMs, const unsigned int intervalMs, const unsigned int minIntervalMs = 0, const unsigned int rampMs = 0) {
+    static_assert(_hasEvent(EV_DURINGLONGPRESS), "The DuringLongPress event is not supported by this configuration.");
+    this->_repeat_delay_ms = _ms16(delayMs);
+    this->_repeat_ms = _ms16(intervalMs);
+    this->_repeat_min_ms = ((minIntervalMs == 0) || (minIntervalMs > intervalMs) || (rampMs == 0)) ? _ms16(intervalMs) : _ms16(minIntervalMs);
+    this->_repeat_ramp_ms = _ms16(rampMs);
+  };
+
+  /**
+   * set # millisec after idle is assumed.
+   */
+  void setIdleMs(const unsigned int ms) {
+    static_assert(_hasEvent(EV_IDLE), "The idle event is not supported by this configuration.");
+    this->_idle_ms = ms;
+  };
+
+  // ----- Attach events functions -----
+  // Every event takes a function without parameter, a parameterized function or
+  // a function receiving the record of the event with the click count, the press
+  // duration, the gaps between the clicks and the time of detection.
+  // They return false when the function is not attached because all maxHandlers
+  // entries of the table are used by other events, passing NULL removes the function.
+
+  /**
+   * Attach an event to be called immediately when a depress is detected.
+   * @param newFunction This function will be called when the event has been detected.
+   */
+  bool attachPress(callbackFunction newFunction);
+  bool attachPress(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachPress(eventHandlerFunction newFunction);
+
+  /**
+   * Attach an event to be called when a single click is detected.
+   * @param newFunction This function will be called when the event has been detected.
+   */
+  bool attachClick(callbackFunction newFunction);
+  bool attachClick(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachClick(eventHandlerFunction newFunction);
+
+  /**
+   * Attach an event to be called after a double click is detected.
+   * @param newFunction This function will be called when the event has been detected.
+   */
+  bool attachDoubleClick(callbackFunction newFunction);
+  bool attachDoubleClick(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachDoubleClick(eventHandlerFunction newFunction);
+
+  /**
+   * Attach an event to be called after a multi click is detected.
+   * @param newFunction This function will be called when the event has been detected.
+   */
+  bool attachMultiClick(callbackFunction newFunction);
+  bool attachMultiClick(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachMultiClick(eventHandlerFunction newFunction);
+
+  /**
+   * Attach an event to fire when the button is pressed and held down.
+   * @param newFunction
+   */
+  bool attachLongPressStart(callbackFunction newFunction);
+  bool attachLongPressStart(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachLongPressStart(eventHandlerFunction newFunction);
+
+  /**
+   * Attach an event to fire as soon as the button is released after a long press.
+   * @param newFunction
+   */
+  bool attachLongPressStop(callbackFunction newFunction);
+  bool attachLongPressStop(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachLongPressStop(eventHandlerFunction newFunction);
+
+  /**
+   * Attach an event to fire periodically while the button is held down.
+   * The period of calls is set by setLongPressIntervalMs(ms).
+   * @param newFunction
+   */
+  bool attachDuringLongPress(callbackFunction newFunction);
+  bool attachDuringLongPress(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachDuringLongPress(eventHandlerFunction newFunction);
+
+  /**
+   * Attach an event when the button is in idle position.
+   * @param newFunction
+   */
+  bool attachIdle(callbackFunction newFunction);
+  bool attachIdle(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachIdle(eventHandlerFunction newFunction);
+
+  /**
+   * Attach an event to be called immediately when the button is released the first time.
+   * The click is confirmed by the click event or superseded by the ClickSuperseded event
+   * when the button is pressed again for a double click, multi click or long press.
+   * @param newFunction This function will be called when the event has been detected.
+   */
+  bool attachTentativeClick(callbackFunction newFunction);
+  bool attachTentativeClick(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachTentativeClick(eventHandlerFunction newFunction);
+
+  /**
+   * Attach an event to be called when a tentative click will not be a single click.
+   * @param newFunction This function will be called when the event has been detected.
+   */
+  bool attachClickSuperseded(callbackFunction newFunction);
+  bool attachClickSuperseded(parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool attachClickSuperseded(eventHandlerFunction newFunction);
+
+  // ----- Attach function objects -----
+  // Lambdas and other function objects with captures that fit into one pointer
+  // like [this] or [&counter] are stored without heap and called without casts.
+  // They require parameterized callbacks.
+
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachPress(const F &f) {
+    return attachPress(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachClick(const F &f) {
+    return attachClick(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachDoubleClick(const F &f) {
+    return attachDoubleClick(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachMultiClick(const F &f) {
+    return attachMultiClick(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachLongPressStart(const F &f) {
+    return attachLongPressStart(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachLongPressStop(const F &f) {
+    return attachLongPressStop(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachDuringLongPress(const F &f) {
+    return attachDuringLongPress(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachIdle(const F &f) {
+    return attachIdle(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachTentativeClick(const F &f) {
+    return attachTentativeClick(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+  template<class F, class = OneButtonIfCapturing<F>>
+  bool attachClickSuperseded(const F &f) {
+    return attachClickSuperseded(OneButtonCallable<F>::invoke, OneButtonCallable<F>::pack(f));
+  };
+
+  // ----- Remove functions -----
+  // Passing NULL, 0 or nullptr to an attach function removes the function of the event.
+
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachPress(const T) {
+    return attachPress((callbackFunction)NULL);
+  };
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachClick(const T) {
+    return attachClick((callbackFunction)NULL);
+  };
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachDoubleClick(const T) {
+    return attachDoubleClick((callbackFunction)NULL);
+  };
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachMultiClick(const T) {
+    return attachMultiClick((callbackFunction)NULL);
+  };
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachLongPressStart(const T) {
+    return attachLongPressStart((callbackFunction)NULL);
+  };
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachLongPressStop(const T) {
+    return attachLongPressStop((callbackFunction)NULL);
+  };
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachDuringLongPress(const T) {
+    return attachDuringLongPress((callbackFunction)NULL);
+  };
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachIdle(const T) {
+    return attachIdle((callbackFunction)NULL);
+  };
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachTentativeClick(const T) {
+    return attachTentativeClick((callbackFunction)NULL);
+  };
+  template<class T, class = OneButtonIfNull<T>>
+  bool attachClickSuperseded(const T) {
+    return attachClickSuperseded((callbackFunction)NULL);
+  };
+
+  // ----- Event queue functions -----
+
+  /**
+   * Add the detected events to a queue instead of calling the attached functions
+   * from within tick(). Only events with an attached function are queued.
+   * This keeps the time in tick() short when it is called from an interrupt routine.
+   * The queue must be dispatched in the main loop. tick() of the buttons using the queue must be
+   * called from one context only as the queue supports a single producer.
+   * @param queue The queue for the events or NULL to call the functions directly again.
+   */
+  template<bool ENABLED = Config::eventQueue>
+  void setEventQueue(OneButtonEventQueue *queue) {
+    static_assert(ENABLED, "The event queue is not supported by this configuration.");
+    this->_eventQueue = queue;
+  };
+
+  /**
+   * Call the functions attached to a queued event.
+   * Within these functions getNumberClicks() and getPressedMs() return the values
+   * from the time the event was detected.
+   * @param e The event taken from the queue.
+   */
+  void dispatch(const OneButtonEvent &e);
+
+  // ----- State machine functions -----
+
+  /**
+   * @brief Call this function every some milliseconds for checking the input
+   * level at the initialized digital pin.
+   */
+  void tick(void);
+
+  /**
+   * @brief Call this function every time the input level has changed.
+   * Using this function no digital input pin is checked because the current
+   * level is given by the parameter.
+   * Run the finite state machine (FSM) using the given level.
+   */
+  void tick(bool activeLevel) {
+    tickAt(activeLevel, _clock());
+  };
+
+  /**
+   * @brief Check the input level at the initialized digital pin using a time read by the caller,
+   * e.g. once for a scan of many buttons or the virtual time of a simulation.
+   * @param ms The current time in the units of the clock.
+   */
+  void tickAt(const time_type ms);
+
+  /**
+   * @brief Run the finite state machine (FSM) using the given level and a time read by the caller.
+   * @param activeLevel The active level of the button.
+   * @param ms The current time in the units of the clock.
+   */
+  void tickAt(const bool activeLevel, const time_type ms) {
+    now = ms;
+    _countTick(ms);
+    _fsm(_debounce(activeLevel));
+  };
+
+  /**
+   * @brief Run the finite state machine (FSM) using a level that was already
+   * debounced by the caller, e.g. by a OneButtonBank.
+   * @param level The debounced active level of the button.
+   * @param ms The current time in the units of the clock, msecs as returned by millis() by default.
+   */
+  void tickDebounced(const bool level, const time_type ms) {
+    now = ms;
+    _countTick(ms);
+    _debouncer.set(level);
+    _fsm(level);
+  };
+
+  // ----- Edge functions -----
+  // These functions are templates so they are only compiled when used.
+
+  /**
+   * Use a buffer for level changes captured with their time.
+   * When set, tick() replays the buffered edges with their recorded times
+   * instead of reading the pin so debouncing and click timing keep the precision
+   * of the capture even when tick() is called seldom.
+   * @param buffer The memory for the edges or NULL to read the pin in tick() again.
+   * @param size The number of edges in the buffer, a power of 2 up to 128.
+   */
+  template<bool ENABLED = Config::edgeBuffer>
+  void setEdgeBuffer(OneButtonEdge *buffer, const uint8_t size);
+
+  /**
+   * Add a level change to the edge buffer, e.g. from a pin change interrupt routine.
+   * @param activeLevel The new active level.
+   * @param ms The time in the units of the clock, msecs as returned by millis() by default, when the level has changed.
+   * @return false when the buffer is full and the edge was dropped.
+   */
+  template<bool ENABLED = Config::edgeBuffer>
+  bool addEdge(const bool activeLevel, const unsigned long ms);
+
+  /**
+   * Read the configured pin and add the level with the current time to the edge buffer.
+   */
+  template<bool ENABLED = Config::edgeBuffer>
+  bool addEdge(void) {
+    if (!_hasPin()) return false;
+    return addEdge<ENABLED>(digitalRead(_pin) == _buttonPressed, (unsigned long)_clock());
+  };
+
+
+  /**
+   * Reset the button state machine.
+   */
+  void reset(void);
+
+
+  /*
+   * return number of clicks in any case: single or multiple clicks
+   */
+  int getNumberClicks(void) {
+    if (Config::eventQueue && this->_dispatchEvent) return this->_dispatchEvent->clicks;
+    return _nClicks;
+  };
+
+
+  /**
+   * @return true when the FSM needs further ticks even without a level change
+   * because a timer based event like click, long press or idle is pending.
+   */
+  bool isPending() const {
+    return (_state != OCS_INIT) || (_hasFunc(EV_IDLE) && !this->_idleState);
+  };
+
+  /**
+   * @brief Get the time of the next timer driven transition of the FSM like the end of debouncing,
+   * click or long press detection, the next DuringLongPress or the idle event.
+   * This allows sleeping until the next deadline instead of calling tick() all the time.
+   * @param deadline Set to the time in the units of the clock when tick() must be called next.
+   * This time may be in the past when tick() is due immediately.
+   * @return false when no timer is pending and only a level change can advance the FSM.
+   */
+  bool nextDeadlineMs(time_type &deadline) const;
+
+  /**
+   * @brief Get the earliest deadline of a group of buttons.
+   * @param buttons The array of buttons.
+   * @param count The number of buttons in the array.
+   * @param deadline Set to the earliest time when tick() must be called next.
+   * @return false when no timer of any button is pending.
+   */
+  static bool nextDeadlineMs(const OneButtonT *buttons, const int count, time_type &deadline);
+
+  /**
+   * @brief Advance the FSMs of an array of buttons with one time and packed active levels.
+   * Buttons that rest in the idle state without a level change are skipped.
+   * @param buttons The array of buttons.
+   * @param count The number of buttons in the array.
+   * @param levels The active levels, bit n % 32 of word n / 32 is the n-th button.
+   * @param ms The current time in the units of the clock.
+   */
+  static void tickAll(OneButtonT *buttons, const int count, const uint32_t *levels, const time_type ms);
+
+  /**
+   * @brief Advance the FSMs of an array of buttons with packed active levels reading the clock once.
+   */
+  static void tickAll(OneButtonT *buttons, const int count, const uint32_t *levels) {
+    tickAll(buttons, count, levels, _clock());
+  };
+
+
+  bool debounce(const bool value) {
+    now = _clock();  // current (relative) time.
+    return _debounce(value);
+  };
+  int debouncedValue() const {
+    return _debouncer.level();
+  };
+
+  /**
+   * @brief Use this function in the DuringLongPress event to get the number of auto repeats it stands for.
+   * @return 1 or more when ticks were late, always 1 without setAutoRepeat().
+   */
+  int getRepeatCount() const {
+    if (Config::eventQueue && this->_dispatchEvent) return this->_dispatchEvent->repeats;
+    return this->_repeatCount;
+  };
+
+  /**
+   * @brief Use this function in the DuringLongPress and LongPressStop events to get the time since the button was pressed.
+   * @return milliseconds from the start of the button press.
+   */
+  unsigned long getPressedMs() {
+    if (Config::eventQueue && this->_dispatchEvent) return this->_dispatchEvent->duration;
+    return (time_type)(_clock() - _startTime) / clock_type::ticksPerMs;
+  };
+
+  // ----- Statistics -----
+  // These functions are templates so they are only compiled when used.
+
+  /**
+   * @return The counters collected since the start or the last resetStats().
+   */
+  template<bool ENABLED = Config::stats>
+  const OneButtonStats &stats() const {
+    static_assert(ENABLED, "The statistics are not supported by this configuration.");
+    return this->_stats;
+  };
+
+  /**
+   * Set all counters to 0.
+   */
+  template<bool ENABLED = Config::stats>
+  void resetStats() {
+    static_assert(ENABLED, "The statistics are not supported by this configuration.");
+    this->_stats = OneButtonStats();
+  };
+
+
+private:
+  // 16 bits are enough for the debounce time in msecs.
+  typedef typename OneButtonIf<(Config::clock_type::ticksPerMs == 1), int16_t, int>::type span_type;
+
+  // The members are ordered by their alignment to avoid padding.
+
+  // These variables that hold information across the upcoming tick calls.
+  // They are initialized once on program start and are updated every time the
+  // tick function is called.
+  time_type now = 0;         // time of the current tick.
+  time_type _startTime = 0;  // start time of current activeLevel change
+
+  span_type _debounce_time = Config::debounceMs * (int)Config::clock_type::ticksPerMs;  // debounce time in the units of the clock.
+  uint16_t _click_ms = Config::clickMs;  // number of msecs before a click is detected.
+  uint16_t _press_ms = Config::pressMs;  // number of msecs before a long button press is detected
+
+  typename Config::debounce_type _debouncer;  // the debounce strategy.
+
+  // The functions acting as event source are held in a dense table with entries for the
+  // attached events only, sorted by the event number as marked in _eventMask.
+  // Parameterized functions are marked in _paramMask.
+  // An entry takes 8 bytes on 32-bit systems and 16 bytes on 64-bit systems,
+  // without parameterized callbacks only the half.
+  typedef OneButtonHandler<Config::paramCallbacks> handler_t;
+
+  uint16_t _eventMask = 0;  // events with an attached function.
+  uint16_t _paramMask = 0;  // events with a parameterized function.
+  handler_t _handlers[Config::maxHandlers];
+
+  /**
+   * Run the finite state machine (FSM) using the given level.
+   */
+  void _fsm(bool activeLevel);
+
+  /**
+   * Run the FSM by the transition table of a fsm_type with its own states.
+   */
+  void _fsmTable(bool activeLevel);
+
+  /**
+   * true when fsm_type uses the table of OneButtonFsm, whose transitions are compiled into _fsm().
+   */
+  static constexpr bool _defaultStates = (&Config::fsm_type::states == &OneButtonFsm::states);
+
+  /**
+   * Run the action of a transition including the change to the next state.
+   */
+  void _action(const uint8_t action, const uint8_t next);
+
+  /**
+   * @return true when the timer of the current state has expired.
+   */
+  bool _timeout(const uint8_t timer);
+
+  /**
+   * @return The timer of a state from the transition table.
+   */
+  static uint8_t _timerOf(const uint8_t state) {
+    typedef typename Config::fsm_type fsm;
+    return (state < fsm::stateCount) ? ONEBUTTON_READ_BYTE(&fsm::states()[state].timer) : (uint8_t)fsm::TIMER_NONE;
+  };
+
+  /**
+   * @return The interval of the auto repeat at the time of the next repeat in msecs.
+   */
+  unsigned int _repeatInterval() const;
+
+  /**
+   * Advance the time of the next auto repeat beyond now.
+   * @return The number of repeats that were due.
+   */
+  uint8_t _countRepeats();
+
+  /**
+   *  Advance to a new state.
+   */
+  void _newState(stateMachine_t nextState) {
+    if (Config::stats && (nextState < 8)) this->_stats.transitions[nextState]++;
+    _state = nextState;
+  };
+
+  /**
+   * End the sequence of clicks and presses.
+   */
+  void _restart(const uint8_t next) {
+    if (_state != next) _newState((stateMachine_t)next);
+    _nClicks = 0;
+    _startTime = now;
+    this->_idleState = false;
+  };
+
+  /**
+   * @return true when a tick with the level changes nothing:
+   * no timer is pending and the button is released, also after debouncing.
+   */
+  bool _isResting(const bool level) const {
+    time_type t;
+    return !level && !isPending() && !_debouncer.level() && !_debouncer.deadline(t, _debounce_time, now);
+  };
+
+  /**
+   * @return The current time of the clock.
+   */
+  static time_type _clock() {
+    return (time_type)Config::clock_type::now();
+  };
+
+  /**
+   * @return A time in msecs limited to 16 bits.
+   */
+  static uint16_t _ms16(const unsigned long ms) {
+    return (ms < 0xFFFFUL) ? (uint16_t)ms : 0xFFFF;
+  };
+
+  /**
+   * @return A time in msecs converted to the units of the clock.
+   */
+  static time_type _ticks(const unsigned long ms) {
+    return (time_type)(ms * Config::clock_type::ticksPerMs);
+  };
+
+  /**
+   * Debounce the level at the time in now.
+   */
+  bool _debounce(const bool value) {
+    if (Config::stats && _debouncer.rejects(value)) this->_stats.bounces++;
+    return _debouncer.debounce(value, now, _debounce_time);
+  };
+
+  /**
+   * Count a tick and the time since the last tick.
+   */
+  void _countTick(const time_type ms) {
+    if (Config::stats) {
+      time_type gap = ms - this->_lastTickTime;
+      if (this->_stats.ticks && (gap > this->_stats.maxTickGapMs)) this->_stats.maxTickGapMs = gap;
+      this->_stats.ticks++;
+      this->_lastTickTime = ms;
+    }
+  };
+
+  /**
+   * Call the attached functions or queue the event.
+   */
+  void _fire(const event_t event);
+  void _callFunc(const event_t event);
+  void _record(const event_t event, OneButtonEvent &e);
+
+  // used as dispatcher in the queued events.
+  static void _dispatch(const OneButtonEvent &e) {
+    static_cast<OneButtonT *>(e.button)->dispatch(e);
+  };
+
+  static constexpr bool _hasEvent(const event_t event) {
+    return (Config::events & (1 << event)) != 0;
+  };
+
+  bool _hasFunc(const event_t event) const {
+    return _hasEvent(event) && (_eventMask & (1 << event));
+  };
+
+  /**
+   * Save a function in the handler table.
+   */
+  bool _attach(const event_t event, callbackFunction newFunction);
+  bool _attach(const event_t event, parameterizedCallbackFunction newFunction, void *parameter);
+  template<bool ENABLED = Config::eventPayload>
+  bool _attach(const event_t event, eventHandlerFunction newFunction);
+  bool _attach(const event_t event, const handler_t *h, const bool isParam, const bool isEvent = false);
+
+  uint8_t _handlerIndex(const event_t event) const {
+    return __builtin_popcount(_eventMask & ((1 << event) - 1));
+  };
+
+  /**
+   * Replay all buffered edges and advance the FSM until the given time.
+   */
+  void _replayEdges(const time_type ms);
+  void _replay(const bool level, const time_type ms);
+  void _replayUntil(const bool level, const time_type ms);
+
+  /**
+   * Get the time when the timer of the current state expires.
+   */
+  bool _timerDeadline(time_type &deadline) const;
+
+  /**
+   * @return true when time a is before time b, also when the timer has wrapped around.
+   */
+  static bool _isBefore(const time_type a, const time_type b) {
+    return (time_type)(a - b) > (time_type)(((time_type)~(time_type)0) >> 1);
+  };
+
+  /**
+   * Take over a deadline when it is earlier than the given one.
+   */
+  static void _earliest(bool &found, time_type &deadline, const time_type ms) {
+    if (!found || _isBefore(ms, deadline)) {
+      deadline = ms;
+      found = true;
+    }
+  };
+};
+
+
+// ----- Implementation -----
+
+// initialize or re-initialize the input pin
+template<class Config>
+void OneButtonT<Config>::setup(const uint8_t pin, const uint8_t mode, const bool activeLow) {
+  _pin = pin;
+
+  if (activeLow) {
+    // the button connects the input pin to GND when pressed.
+    _buttonPressed = LOW;
+
+  } else {
+    // the button connects the input pin to VCC when pressed.
+    _buttonPressed = HIGH;
+  }
+
+  pinMode(pin, mode);
+}  // setup
+
+
+// save function for click event
+template<class Config>
+bool OneButtonT<Config>::attachPress(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_PRESS), "The press event is not supported by this configuration.");
+  return _attach(EV_PRESS, newFunction);
+}  // attachPress
+
+
+// save function for parameterized click event
+template<class Config>
+bool OneButtonT<Config>::attachPress(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_PRESS), "The press event is not supported by this configuration.");
+  return _attach(EV_PRESS, newFunction, parameter);
+}  // attachPress
+
+
+// save function receiving the event record for press event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachPress(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_PRESS), "The press event is not supported by this configuration.");
+  return _attach<ENABLED>(EV_PRESS, newFunction);
+}  // attachPress
+
+
+// save function for click event
+template<class Config>
+bool OneButtonT<Config>::attachClick(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_CLICK), "The click event is not supported by this configuration.");
+  return _attach(EV_CLICK, newFunction);
+}  // attachClick
+
+
+// save function for parameterized click event
+template<class Config>
+bool OneButtonT<Config>::attachClick(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_CLICK), "The click event is not supported by this configuration.");
+  return _attach(EV_CLICK, newFunction, parameter);
+}  // attachClick
+
+
+// save function receiving the event record for click event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachClick(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_CLICK), "The click event is not supported by this configuration.");
+  return _attach<ENABLED>(EV_CLICK, newFunction);
+}  // attachClick
+
+
+// save function for doubleClick event
+template<class Config>
+bool OneButtonT<Config>::attachDoubleClick(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_DOUBLECLICK), "The doubleClick event is not supported by this configuration.");
+  if (!_attach(EV_DOUBLECLICK, newFunction)) return false;
+  _maxClicks = max(_maxClicks, (uint8_t)2);
+  return true;
+}  // attachDoubleClick
+
+
+// save function for parameterized doubleClick event
+template<class Config>
+bool OneButtonT<Config>::attachDoubleClick(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_DOUBLECLICK), "The doubleClick event is not supported by this configuration.");
+  if (!_attach(EV_DOUBLECLICK, newFunction, parameter)) return false;
+  _maxClicks = max(_maxClicks, (uint8_t)2);
+  return true;
+}  // attachDoubleClick
+
+
+// save function receiving the event record for doubleClick event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachDoubleClick(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_DOUBLECLICK), "The doubleClick event is not supported by this configuration.");
+  if (!_attach<ENABLED>(EV_DOUBLECLICK, newFunction)) return false;
+  _maxClicks = max(_maxClicks, (uint8_t)2);
+  return true;
+}  // attachDoubleClick
+
+
+// save function for multiClick event
+template<class Config>
+bool OneButtonT<Config>::attachMultiClick(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_MULTICLICK), "The multiClick event is not supported by this configuration.");
+  if (!_attach(EV_MULTICLICK, newFunction)) return false;
+  _maxClicks = max(_maxClicks, (uint8_t)100);
+  return true;
+}  // attachMultiClick
+
+
+// save function for parameterized MultiClick event
+template<class Config>
+bool OneButtonT<Config>::attachMultiClick(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_MULTICLICK), "The multiClick event is not supported by this configuration.");
+  if (!_attach(EV_MULTICLICK, newFunction, parameter)) return false;
+  _maxClicks = max(_maxClicks, (uint8_t)100);
+  return true;
+}  // attachMultiClick
+
+
+// save function receiving the event record for MultiClick event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachMultiClick(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_MULTICLICK), "The multiClick event is not supported by this configuration.");
+  if (!_attach<ENABLED>(EV_MULTICLICK, newFunction)) return false;
+  _maxClicks = max(_maxClicks, (uint8_t)100);
+  return true;
+}  // attachMultiClick
+
+
+// save function for longPressStart event
+template<class Config>
+bool OneButtonT<Config>::attachLongPressStart(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_LONGPRESSSTART), "The longPressStart event is not supported by this configuration.");
+  return _attach(EV_LONGPRESSSTART, newFunction);
+}  // attachLongPressStart
+
+
+// save function for parameterized longPressStart event
+template<class Config>
+bool OneButtonT<Config>::attachLongPressStart(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_LONGPRESSSTART), "The longPressStart event is not supported by this configuration.");
+  return _attach(EV_LONGPRESSSTART, newFunction, parameter);
+}  // attachLongPressStart
+
+
+// save function receiving the event record for longPressStart event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachLongPressStart(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_LONGPRESSSTART), "The longPressStart event is not supported by this configuration.");
+  return _attach<ENABLED>(EV_LONGPRESSSTART, newFunction);
+}  // attachLongPressStart
+
+
+// save function for longPressStop event
+template<class Config>
+bool OneButtonT<Config>::attachLongPressStop(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_LONGPRESSSTOP), "The longPressStop event is not supported by this configuration.");
+  return _attach(EV_LONGPRESSSTOP, newFunction);
+}  // attachLongPressStop
+
+
+// save function for parameterized longPressStop event
+template<class Config>
+bool OneButtonT<Config>::attachLongPressStop(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_LONGPRESSSTOP), "The longPressStop event is not supported by this configuration.");
+  return _attach(EV_LONGPRESSSTOP, newFunction, parameter);
+}  // attachLongPressStop
+
+
+// save function receiving the event record for longPressStop event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachLongPressStop(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_LONGPRESSSTOP), "The longPressStop event is not supported by this configuration.");
+  return _attach<ENABLED>(EV_LONGPRESSSTOP, newFunction);
+}  // attachLongPressStop
+
+
+// save function for during longPress event
+template<class Config>
+bool OneButtonT<Config>::attachDuringLongPress(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_DURINGLONGPRESS), "The DuringLongPress event is not supported by this configuration.");
+  return _attach(EV_DURINGLONGPRESS, newFunction);
+}  // attachDuringLongPress
+
+
+// save function for parameterized during longPress event
+template<class Config>
+bool OneButtonT<Config>::attachDuringLongPress(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_DURINGLONGPRESS), "The DuringLongPress event is not supported by this configuration.");
+  return _attach(EV_DURINGLONGPRESS, newFunction, parameter);
+}  // attachDuringLongPress
+
+
+// save function receiving the event record for during longPress event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachDuringLongPress(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_DURINGLONGPRESS), "The DuringLongPress event is not supported by this configuration.");
+  return _attach<ENABLED>(EV_DURINGLONGPRESS, newFunction);
+}  // attachDuringLongPress
+
+
+// save function for idle button event
+template<class Config>
+bool OneButtonT<Config>::attachIdle(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_IDLE), "The idle event is not supported by this configuration.");
+  return _attach(EV_IDLE, newFunction);
+}  // attachIdle
+
+
+// save function for parameterized idle button event
+template<class Config>
+bool OneButtonT<Config>::attachIdle(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_IDLE), "The idle event is not supported by this configuration.");
+  return _attach(EV_IDLE, newFunction, parameter);
+}  // attachIdle
+
+
+// save function receiving the event record for idle button event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachIdle(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_IDLE), "The idle event is not supported by this configuration.");
+  return _attach<ENABLED>(EV_IDLE, newFunction);
+}  // attachIdle
+
+
+// save function for tentative click event
+template<class Config>
+bool OneButtonT<Config>::attachTentativeClick(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_TENTATIVECLICK), "The tentativeClick event is not supported by this configuration.");
+  return _attach(EV_TENTATIVECLICK, newFunction);
+}  // attachTentativeClick
+
+
+// save function for parameterized tentative click event
+template<class Config>
+bool OneButtonT<Config>::attachTentativeClick(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_TENTATIVECLICK), "The tentativeClick event is not supported by this configuration.");
+  return _attach(EV_TENTATIVECLICK, newFunction, parameter);
+}  // attachTentativeClick
+
+
+// save function receiving the event record for tentative click event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachTentativeClick(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_TENTATIVECLICK), "The tentativeClick event is not supported by this configuration.");
+  return _attach<ENABLED>(EV_TENTATIVECLICK, newFunction);
+}  // attachTentativeClick
+
+
+// save function for click superseded event
+template<class Config>
+bool OneButtonT<Config>::attachClickSuperseded(callbackFunction newFunction) {
+  static_assert(_hasEvent(EV_CLICKSUPERSEDED), "The clickSuperseded event is not supported by this configuration.");
+  return _attach(EV_CLICKSUPERSEDED, newFunction);
+}  // attachClickSuperseded
+
+
+// save function for parameterized click superseded event
+template<class Config>
+bool OneButtonT<Config>::attachClickSuperseded(parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(_hasEvent(EV_CLICKSUPERSEDED), "The clickSuperseded event is not supported by this configuration.");
+  return _attach(EV_CLICKSUPERSEDED, newFunction, parameter);
+}  // attachClickSuperseded
+
+
+// save function receiving the event record for click superseded event
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::attachClickSuperseded(eventHandlerFunction newFunction) {
+  static_assert(_hasEvent(EV_CLICKSUPERSEDED), "The clickSuperseded event is not supported by this configuration.");
+  return _attach<ENABLED>(EV_CLICKSUPERSEDED, newFunction);
+}  // attachClickSuperseded
+
+
+/**
+ * @brief Save a function in the handler table.
+ * Passing NULL removes the function from the event.
+ */
+template<class Config>
+bool OneButtonT<Config>::_attach(const event_t event, callbackFunction newFunction) {
+  handler_t h;
+  h.func = newFunction;
+  if (Config::paramCallbacks) h.param = NULL;
+  return _attach(event, newFunction ? &h : NULL, false);
+}  // _attach
+
+
+template<class Config>
+bool OneButtonT<Config>::_attach(const event_t event, parameterizedCallbackFunction newFunction, void *parameter) {
+  static_assert(Config::paramCallbacks, "Parameterized callbacks are not supported by this configuration.");
+  handler_t h;
+  h.paramFunc = newFunction;
+  h.param = parameter;
+  return _attach(event, newFunction ? &h : NULL, true);
+}  // _attach
+
+
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::_attach(const event_t event, eventHandlerFunction newFunction) {
+  static_assert(ENABLED, "Functions receiving the event record are not supported by this configuration.");
+  handler_t h;
+  h.eventFunc = newFunction;
+  if (Config::paramCallbacks) h.param = NULL;
+  return _attach(event, newFunction ? &h : NULL, false, true);
+}  // _attach
+
+
+/**
+ * @brief Insert or replace an entry in the handler table or remove it when h is NULL.
+ * The entries are sorted by event so the index of an event is the number
+ * of attached events with a lower number.
+ * @return false when the table has no free entry for a new event.
+ */
+template<class Config>
+bool OneButtonT<Config>::_attach(const event_t event, const handler_t *h, const bool isParam, const bool isEvent) {
+  const uint16_t bit = (1 << event);
+  const uint8_t count = __builtin_popcount(_eventMask);
+  const uint8_t index = _handlerIndex(event);
+
+  if (h) {
+    if (!(_eventMask & bit)) {
+      // a new entry is required.
+      if (count >= Config::maxHandlers) return false;  // the table is full.
+      for (uint8_t n = count; n > index; n--) _handlers[n] = _handlers[n - 1];
+      _eventMask |= bit;
+    }
+    _handlers[index] = *h;
+    if (isParam) {
+      _paramMask |= bit;
+    } else {
+      _paramMask &= ~bit;
+    }
+    if (Config::eventPayload) {
+      if (isEvent) {
+        this->_eventFuncMask |= bit;
+      } else {
+        this->_eventFuncMask &= ~bit;
+      }
+    }
+
+  } else if (_eventMask & bit) {
+    // remove the entry.
+    for (uint8_t n = index; n < count - 1; n++) _handlers[n] = _handlers[n + 1];
+    _eventMask &= ~bit;
+    _paramMask &= ~bit;
+    if (Config::eventPayload) this->_eventFuncMask &= ~bit;
+  }
+  return true;
+}  // _attach
+
+
+template<class Config>
+void OneButtonT<Config>::reset(void) {
+  if (_state != OCS_INIT) _newState(OCS_INIT);
+  _nClicks = 0;
+  _startTime = _clock();
+  this->_idleState = false;
+}
+
+
+/**
+ * @brief Check input of the configured pin,
+ * debounce button state and then
+ * advance the finite state machine (FSM).
+ */
+template<class Config>
+void OneButtonT<Config>::tick(void) {
+  tickAt(_clock());
+}  // tick()
+
+
+template<class Config>
+void OneButtonT<Config>::tickAt(const time_type ms) {
+  if (Config::edgeBuffer && this->_edges) {
+    _countTick(ms);
+    _replayEdges(ms);
+
+  } else if (_hasPin()) {
+    now = ms;
+    _countTick(now);
+    _fsm(_debounce(digitalRead(_pin) == _buttonPressed));
+  }
+}  // tickAt()
+
+
+// get the time of the next timer driven transition.
+template<class Config>
+bool OneButtonT<Config>::nextDeadlineMs(time_type &deadline) const {
+  bool found = false;
+  time_type ms = 0;
+
+  // edges waiting for replay or a level waiting for debouncing.
+  if (Config::edgeBuffer && this->_edges) {
+    if (this->_edgeTail != __atomic_load_n(&this->_edgeHead, __ATOMIC_ACQUIRE)) _earliest(found, deadline, now);
+    if (this->_edgeLevel != _debouncer.level()) _earliest(found, deadline, this->_edgeTime + _debouncer.window(_debounce_time));
+
+  } else if (_debouncer.deadline(ms, _debounce_time, now)) {
+    _earliest(found, deadline, ms);
+  }
+
+  if (_timerDeadline(ms)) _earliest(found, deadline, ms);
+  return found;
+}  // nextDeadlineMs()
+
+
+// get the time when the timer of the current state expires.
+template<class Config>
+bool OneButtonT<Config>::_timerDeadline(time_type &deadline) const {
+  bool found = false;
+  time_type ms = 0;
+
+  const uint8_t timer = _timerOf(_state);
+  switch (timer) {
+    case Config::fsm_type::TIMER_NONE:
+      break;
+
+    case Config::fsm_type::TIMER_IDLE:
+      if (_hasFunc(EV_IDLE) && !this->_idleState) _earliest(found, deadline, _startTime + _ticks(this->_idle_ms) + 1);
+      break;
+
+    case Config::fsm_type::TIMER_PRESS:
+      _earliest(found, deadline, _startTime + _ticks(_press_ms) + 1);
+      break;
+
+    case Config::fsm_type::TIMER_CLICK:
+      _earliest(found, deadline, (_nClicks == _maxClicks) ? now : (time_type)(_startTime + _ticks(_click_ms)));
+      break;
+
+    case Config::fsm_type::TIMER_DURING:
+      if (_hasFunc(EV_DURINGLONGPRESS)) _earliest(found, deadline, this->_nextDuringTime);
+      break;
+
+    default:
+      if (Config::fsm_type::deadline(*this, timer, ms)) _earliest(found, deadline, ms);
+      break;
+  }  // switch
+  return found;
+}  // _timerDeadline()
+
+
+// get the earliest deadline of a group of buttons.
+template<class Config>
+bool OneButtonT<Config>::nextDeadlineMs(const OneButtonT *buttons, const int count, time_type &deadline) {
+  bool found = false;
+  time_type ms = 0;
+
+  for (int n = 0; n < count; n++) {
+    if (buttons[n].nextDeadlineMs(ms)) _earliest(found, deadline, ms);
+  }
+  return found;
+}  // nextDeadlineMs()
+
+
+// advance an array of buttons with one time and packed levels.
+template<class Config>
+void OneButtonT<Config>::tickAll(OneButtonT *buttons, const int count, const uint32_t *levels, const time_type ms) {
+  uint32_t word = 0;
+
+  for (int n = 0; n < count; n++) {
+    if ((n & 31) == 0) word = levels[n >> 5];
+    if (n + 1 < count) __builtin_prefetch(&buttons[n + 1]);
+
+    const bool level = (word >> (n & 31)) & 1;
+    if (!buttons[n]._isResting(level)) buttons[n].tickAt(level, ms);
+  }
+}  // tickAll()
+
+
+// use a buffer for captured edges.
+template<class Config>
+template<bool ENABLED>
+void OneButtonT<Config>::setEdgeBuffer(OneButtonEdge *buffer, const uint8_t size) {
+  static_assert(ENABLED, "The edge buffer is not supported by this configuration.");
+
+  // use the largest power of 2 fitting into the buffer.
+  uint8_t s = 1;
+  while ((s < 128) && ((s << 1) <= size)) s <<= 1;
+
+  this->_edgeMask = s - 1;
+  this->_edgeHead = this->_edgeTail = 0;
+  this->_edgeDrops = this->_edgeDropsSeen = 0;
+  this->_edgeLevel = isPinActive();
+  this->_edgeTime = _clock();
+  this->_edges = buffer;
+}  // setEdgeBuffer
+
+
+/**
+ * @brief Add an edge to the buffer, this function is safe to be called from an interrupt routine.
+ * The indices are running freely and only the lower bits address the buffer.
+ */
+template<class Config>
+template<bool ENABLED>
+bool OneButtonT<Config>::addEdge(const bool activeLevel, const unsigned long ms) {
+  static_assert(ENABLED, "The edge buffer is not supported by this configuration.");
+  if (!this->_edges) return false;
+
+  uint8_t head = this->_edgeHead;
+  if ((uint8_t)(head - __atomic_load_n(&this->_edgeTail, __ATOMIC_ACQUIRE)) > this->_edgeMask) {
+    this->_edgeDrops++;
+    return false;
+  }
+  this->_edges[head & this->_edgeMask].time = ms;
+  this->_edges[head & this->_edgeMask].level = activeLevel;
+  __atomic_store_n(&this->_edgeHead, (uint8_t)(head + 1), __ATOMIC_RELEASE);
+  return true;
+}  // addEdge()
+
+
+/**
+ * @brief Advance the FSM with a level at a given time.
+ * Calls going back in time are ignored.
+ */
+template<class Config>
+void OneButtonT<Config>::_replay(const bool level, const time_type ms) {
+  if (_isBefore(ms, now)) return;
+
+  now = ms;
+  _fsm(_debounce(level));
+}  // _replay()
+
+
+/**
+ * @brief Advance the FSM with a level until the given time
+ * and stop at every timer that expires before.
+ */
+template<class Config>
+void OneButtonT<Config>::_replayUntil(const bool level, const time_type ms) {
+  time_type deadline;
+  bool due = false;
+
+  while (_timerDeadline(deadline) && _isBefore(deadline, ms)) {
+    if (_isBefore(now, deadline)) {
+      due = false;
+    } else {
+      // a timer expiring at once is taken over 1 unit later like by the next tick,
+      // but only once in a row so a DuringLongPress without interval fires once.
+      if (due) break;
+      deadline = now + 1;
+      if (!_isBefore(deadline, ms)) break;
+      due = true;
+    }
+    _replay(level, deadline);
+  }
+
+  // the FSM runs once per time like by polling.
+  if (_isBefore(now, ms)) _replay(level, ms);
+}  // _replayUntil()
+
+
+/**
+ * @brief Replay the buffered edges with their recorded times.
+ * Before every edge the FSM advances with the previous level to the timers expiring in between,
+ * to the end of the debounce time and to the time of the edge so timers expire in the right order.
+ */
+template<class Config>
+void OneButtonT<Config>::_replayEdges(const time_type ms) {
+  time_type stableMs;
+
+  while (this->_edgeTail != __atomic_load_n(&this->_edgeHead, __ATOMIC_ACQUIRE)) {
+    OneButtonEdge e = this->_edges[this->_edgeTail & this->_edgeMask];
+    __atomic_store_n(&this->_edgeTail, (uint8_t)(this->_edgeTail + 1), __ATOMIC_RELEASE);
+
+    // the edge time keeps the lower bits of the clock only.
+    const time_type t = ms + (time_type)(long)(e.time - (unsigned long)ms);
+    stableMs = _debouncer.window(_debounce_time);
+    // a level is stable when it lasts longer than the debounce time before the edge.
+    if ((time_type)(t - this->_edgeTime) > stableMs) _replayUntil(this->_edgeLevel, this->_edgeTime + stableMs);
+    _replayUntil(this->_edgeLevel, t - 1);  // the previous level lasts until just before the edge.
+    this->_edgeLevel = e.level;
+    this->_edgeTime = t;
+    _replay(this->_edgeLevel, t);
+  }
+
+  if (this->_edgeDrops != this->_edgeDropsSeen) {
+    // edges got lost, continue with the current level of the pin.
+    this->_edgeDropsSeen = this->_edgeDrops;
+    if (_hasPin() && (isPinActive() != this->_edgeLevel)) {
+      this->_edgeLevel = !this->_edgeLevel;
+      this->_edgeTime = ms;
+    }
+  }
+
+  stableMs = _debouncer.window(_debounce_time);
+  if (!_isBefore(ms, this->_edgeTime + stableMs)) _replayUntil(this->_edgeLevel, this->_edgeTime + stableMs);
+  _replayUntil(this->_edgeLevel, ms);
+}  // _replayEdges()
+
+
+// run the attached functions for a queued event.
+template<class Config>
+void OneButtonT<Config>::dispatch(const OneButtonEvent &e) {
+  this->_dispatchEvent = &e;
+  _callFunc((event_t)e.event);
+  this->_dispatchEvent = NULL;
+}  // dispatch()
+
+
+/**
+ * @brief Queue the event or call the attached function directly.
+ */
+template<class Config>
+void OneButtonT<Config>::_fire(const event_t event) {
+  if (Config::stats) this->_stats.events[event]++;
+
+  if (Config::eventQueue && this->_eventQueue) {
+    if (_hasFunc(event)) {
+      OneButtonEvent e;
+      _record(event, e);
+      _pushEvent(this->_eventQueue, e);
+    }
+  } else {
+    _callFunc(event);
+  }
+}  // _fire()
+
+
+/**
+ * @brief Fill the record of an event with the values at the time of detection.
+ */
+template<class Config>
+void OneButtonT<Config>::_record(const event_t event, OneButtonEvent &e) {
+  e.button = this;
+  e.dispatcher = _dispatch;
+  e.event = event;
+  e.clicks = _nClicks;
+  e.repeats = (event == EV_DURINGLONGPRESS) ? this->_repeatCount : 0;
+  for (uint8_t n = 0; n < ONEBUTTONEVENT_GAPS; n++) e.gaps[n] = 0;
+  e.duration = 0;
+  e.time = now;
+
+  if ((event == EV_LONGPRESSSTART) || (event == EV_DURINGLONGPRESS) || (event == EV_LONGPRESSSTOP)) {
+    e.duration = (time_type)(now - _startTime) / Config::clock_type::ticksPerMs;
+
+  } else if (Config::eventPayload && (event != EV_PRESS) && (event != EV_IDLE)) {
+    // the clicks: _startTime is the time of the last release.
+    for (uint8_t n = 0; n < ONEBUTTONEVENT_GAPS; n++) e.gaps[n] = this->_gapsMs[n];
+    if (event != EV_CLICKSUPERSEDED) e.duration = (time_type)(_startTime - this->_pressTime) / Config::clock_type::ticksPerMs;
+  }
+}  // _record()
+
+
+/**
+ * @brief Call the function attached to the event.
+ */
+template<class Config>
+void OneButtonT<Config>::_callFunc(const event_t event) {
+  const uint16_t bit = (1 << event);
+
+  if (_hasFunc(event)) {
+    const handler_t &h = _handlers[_handlerIndex(event)];
+    const unsigned long start = Config::stats ? micros() : 0;
+
+    if (Config::eventPayload && (this->_eventFuncMask & bit)) {
+      if (Config::eventQueue && this->_dispatchEvent) {
+        h.eventFunc(*this->_dispatchEvent);
+      } else {
+        OneButtonEvent e;
+        _record(event, e);
+        h.eventFunc(e);
+      }
+    } else if (Config::paramCallbacks && (_paramMask & bit)) {
+      h.paramFunc(h.param);
+    } else {
+      h.func();
+    }
+
+    if (Config::stats) {
+      const unsigned long us = micros() - start;
+      this->_stats.callbacks++;
+      this->_stats.callbackTotalUs += us;
+      if (us > this->_stats.callbackMaxUs) this->_stats.callbackMaxUs = us;
+    }
+  }
+}  // _callFunc()
+
+
+/**
+ * @brief Check the timer of the current state.
+ */
+template<class Config>
+bool OneButtonT<Config>::_timeout(const uint8_t timer) {
+  const time_type waitTime = (time_type)(now - _startTime);
+
+  switch (timer) {
+    case Config::fsm_type::TIMER_NONE:
+      return false;
+
+    case Config::fsm_type::TIMER_IDLE:
+      // on idle for idle_ms call idle function
+      return _hasFunc(EV_IDLE) && !this->_idleState && (waitTime > _ticks(this->_idle_ms));
+
+    case Config::fsm_type::TIMER_PRESS:
+      return waitTime > _ticks(_press_ms);
+
+    case Config::fsm_type::TIMER_CLICK:
+      return (waitTime >= _ticks(_click_ms)) || (_nClicks == _maxClicks);
+
+    case Config::fsm_type::TIMER_DURING:
+      return _hasEvent(EV_DURINGLONGPRESS) && !_isBefore(now, this->_nextDuringTime);
+
+    default:
+      return Config::fsm_type::timeout(*this, timer);
+  }  // switch
+}  // _timeout()
+
+
+/**
+ * @brief Get the interval of the auto repeat, shrinking linearly during the ramp.
+ */
+template<class Config>
+unsigned int OneButtonT<Config>::_repeatInterval() const {
+  const uint16_t elapsed = this->_repeatElapsedMs;
+  unsigned int ms = this->_repeat_min_ms;
+
+  if (elapsed < this->_repeat_ramp_ms) {
+    ms = this->_repeat_ms - (unsigned int)((unsigned long)(this->_repeat_ms - this->_repeat_min_ms) * elapsed / this->_repeat_ramp_ms);
+  }
+  return ms ? ms : 1;
+}  // _repeatInterval()
+
+
+/**
+ * @brief Count the due auto repeats and schedule the next one.
+ */
+template<class Config>
+uint8_t OneButtonT<Config>::_countRepeats() {
+  uint8_t count = 0;
+
+  do {
+    const unsigned int ms = _repeatInterval();
+    count++;
+    this->_nextDuringTime += _ticks(ms);
+    if (this->_repeatElapsedMs < this->_repeat_ramp_ms) this->_repeatElapsedMs = _ms16((unsigned long)this->_repeatElapsedMs + ms);
+  } while (!_isBefore(now, this->_nextDuringTime) && (count < 255));
+
+  // tick() was very late, continue from now.
+  if (!_isBefore(now, this->_nextDuringTime)) this->_nextDuringTime = now + _ticks(_repeatInterval());
+  return count;
+}  // _countRepeats()
+
+
+/**
+ * @brief Run the action of a transition.
+ * The actions change the state where the attached functions expect it.
+ */
+template<class Config>
+void OneButtonT<Config>::_action(const uint8_t action, const uint8_t next) {
+  typedef typename Config::fsm_type fsm;
+
+  switch (action) {
+    case fsm::ACT_IDLE:
+    case fsm::ACT_IDLE_PRESS:
+      this->_idleState = true;
+      _fire(EV_IDLE);
+      if (action == fsm::ACT_IDLE) break;
+      // fall through
+
+    case fsm::ACT_PRESS:
+      _newState((stateMachine_t)next);
+      _startTime = now;  // remember starting time
+      _nClicks = 0;
+      if (Config::eventPayload) {
+        this->_pressTime = now;
+        for (uint8_t n = 0; n < ONEBUTTONEVENT_GAPS; n++) this->_gapsMs[n] = 0;
+      }
+      _fire(EV_PRESS);
+      return;
+
+    case fsm::ACT_RELEASE:
+      // count as a short button down
+      _newState((stateMachine_t)next);
+      _startTime = now;  // remember starting time
+      _nClicks++;
+
+      // report the first click at once when it may be confirmed or superseded later.
+      if (_hasEvent(EV_TENTATIVECLICK) && (_nClicks == 1)) _fire(EV_TENTATIVECLICK);
+      return;
+
+    case fsm::ACT_REPRESS:
+      // button is down again
+      _newState((stateMachine_t)next);
+      if (Config::eventPayload) {
+        const unsigned long gap = (time_type)(now - _startTime) / Config::clock_type::ticksPerMs;
+        if (_nClicks <= ONEBUTTONEVENT_GAPS) this->_gapsMs[_nClicks - 1] = (gap < 0xFFFF) ? gap : 0xFFFF;
+        this->_pressTime = now;
+      }
+      _startTime = now;  // remember starting time
+
+      // the first click will not be a single click.
+      if (_hasEvent(EV_CLICKSUPERSEDED) && (_nClicks == 1)) _fire(EV_CLICKSUPERSEDED);
+      return;
+
+    case fsm::ACT_CLICKS:
+      // now we know how many clicks have been made.
+      if (_nClicks == 1) {
+        _fire(EV_CLICK);
+      } else if (_nClicks == 2) {
+        _fire(EV_DOUBLECLICK);
+      } else {
+        _fire(EV_MULTICLICK);
+      }
+      _restart(next);
+      return;
+
+    case fsm::ACT_LONGSTART:
+      if (_hasEvent(EV_DURINGLONGPRESS)) {
+        // the first DuringLongPress event follows at once or after the delay of the auto repeat.
+        this->_nextDuringTime = this->_repeat_ms ? (time_type)(now + _ticks(this->_repeat_delay_ms)) : now;
+        this->_repeatElapsedMs = 0;
+      }
+      _fire(EV_LONGPRESSSTART);
+      break;
+
+    case fsm::ACT_DURING:
+      if (this->_repeat_ms) {
+        this->_repeatCount = _countRepeats();
+      } else {
+        this->_repeatCount = 1;
+        this->_nextDuringTime = now + _ticks(this->_long_press_interval_ms);
+      }
+      _fire(EV_DURINGLONGPRESS);
+      break;
+
+    case fsm::ACT_LONGSTOP:
+      _newState((stateMachine_t)next);
+      _fire(EV_LONGPRESSSTOP);
+      _restart(next);
+      return;
+
+    case fsm::ACT_RESTART:
+      _restart(next);
+      return;
+
+    default:
+      if (action >= fsm::ACT_USER) {
+        fsm::action(*this, action, next);
+        return;
+      }
+      break;
+  }  // switch
+
+  if (_state != next) _newState((stateMachine_t)next);
+}  // _action()
+
+
+/**
+ * @brief Run the finite state machine (FSM) using the given level.
+ * The transitions of the OneButtonFsm table are compiled into a switch with the timer of every
+ * state known, so the timers of events without an attached function cost nothing.
+ * A fsm_type with its own states runs the transition table instead.
+ */
+template<class Config>
+void OneButtonT<Config>::_fsm(bool activeLevel) {
+  typedef typename Config::fsm_type fsm;
+
+  if (!_defaultStates) {
+    _fsmTable(activeLevel);
+    return;
+  }
+
+  switch (_state) {
+    case OCS_INIT:
+      if (activeLevel) {
+        _action(_timeout(fsm::TIMER_IDLE) ? fsm::ACT_IDLE_PRESS : fsm::ACT_PRESS, OCS_DOWN);
+      } else if (_timeout(fsm::TIMER_IDLE)) {
+        _action(fsm::ACT_IDLE, OCS_INIT);
+      }
+      break;
+
+    case OCS_DOWN:
+      if (!activeLevel) {
+        _action(fsm::ACT_RELEASE, OCS_COUNT);
+      } else if (_timeout(fsm::TIMER_PRESS)) {
+        _action(fsm::ACT_LONGSTART, OCS_PRESS);
+      }
+      break;
+
+    case OCS_UP:
+      _action(fsm::ACT_RELEASE, OCS_COUNT);
+      break;
+
+    case OCS_COUNT:
+      if (activeLevel) {
+        _action(fsm::ACT_REPRESS, OCS_DOWN);
+      } else if (_timeout(fsm::TIMER_CLICK)) {
+        _action(fsm::ACT_CLICKS, OCS_INIT);
+      }
+      break;
+
+    case OCS_PRESS:
+      if (!activeLevel) {
+        _action(fsm::ACT_LONGSTOP, OCS_INIT);
+      } else if (_timeout(fsm::TIMER_DURING)) {
+        _action(fsm::ACT_DURING, OCS_PRESS);
+      }
+      break;
+
+    case OCS_PRESSEND:
+      _action(fsm::ACT_LONGSTOP, OCS_INIT);
+      break;
+
+    default:
+      // the unused rows of the table restart, an unknown state resets the state machine.
+      if ((uint8_t)_state < fsm::stateCount) {
+        _action(fsm::ACT_RESTART, OCS_INIT);
+      } else {
+        _newState(OCS_INIT);
+      }
+      break;
+  }  // switch
+}  // _fsm()
+
+
+/**
+ * @brief Run the finite state machine (FSM) by the transition table.
+ * The transition is taken from the table row of the current state by the input class
+ * given by the level and the timer of the state.
+ */
+template<class Config>
+void OneButtonT<Config>::_fsmTable(bool activeLevel) {
+  typedef typename Config::fsm_type fsm;
+
+  // unknown state detected -> reset state machine
+  if ((uint8_t)_state >= fsm::stateCount) {
+    _newState(OCS_INIT);
+    return;
+  }
+
+  const OneButtonFsmState *row = &fsm::states()[_state];
+  const uint8_t timer = ONEBUTTON_READ_BYTE(&row->timer);
+  const uint8_t input = (activeLevel ? 1 : 0) | ((timer != fsm::TIMER_NONE) && _timeout(timer) ? 2 : 0);
+
+  const OneButtonTransition *t = &row->on[input];
+  const uint8_t next = ONEBUTTON_READ_BYTE(&t->next);
+  const uint8_t action = ONEBUTTON_READ_BYTE(&t->action);
+
+  if (action != fsm::ACT_NONE) {
+    _action(action, next);
+  } else if (next != (uint8_t)_state) {
+    _newState((stateMachine_t)next);
+  }
+}  // _fsmTable()
+
+#endif
@@ -7,166 +7,48 @@
 // http://www.mathertel.de/Arduino
 // -----
 // 01.12.2023 created from OneButtonTiny to support tiny environments.
+// 16.10.2026 Using the OneButtonT template with a reduced configuration.
 // -----
 
 #ifndef OneButtonTiny_h
 #define OneButtonTiny_h
 
 #include "Arduino.h"
+#include "OneButtonT.h"
+
+/**
+ * The configuration of the OneButtonTiny class supporting the click, doubleClick
+ * and longPressStart events with simple callback functions only.
+ * Times are stored in 16 bits so the timing values must stay below 32767 msecs.
+ */
+struct OneButtonTinyConfig {
+  typedef uint16_t time_type;
+  typedef OneButtonDebounceTime<time_type> debounce_type;
+  typedef OneButtonClockMillis clock_type;
+  typedef OneButtonFsm fsm_type;
+
+  static constexpr uint16_t events = (1 << OneButtonBase::EV_CLICK) | (1 << OneButtonBase::EV_DOUBLECLICK) | (1 << OneButtonBase::EV_LONGPRESSSTART);
+  static constexpr bool paramCallbacks = false;
+  static constexpr uint8_t maxHandlers = 3;  // attach functions return false when full.
+  static constexpr uint8_t maxClicks = 2;    // a second click is always awaited like in former versions.
+  static constexpr bool eventPayload = false;
+  static constexpr bool eventQueue = false;
+  static constexpr bool edgeBuffer = false;
+  static constexpr bool stats = false;
+
+  static constexpr int debounceMs = 50;
+  static constexpr unsigned int clickMs = 400;
+  static constexpr unsigned int pressMs = 800;
+  static constexpr unsigned int idleMs = 1000;
+};
 
-// ----- Callback function types -----
-
-extern "C" {
-  typedef void (*callbackFunction)(void);
-}
-
-
-class OneButtonTiny {
-public:
-  // ----- Constructor -----
-
-  /**
-   * Initialize the OneButtonTiny library.
-   * @param pin The pin to be used for input from a momentary button.
-   * @param activeLow Set to true when the input level is LOW when the button is pressed, Default is true.
-   * @param pullupActive Activate the internal pullup when available. Default is true.
-   */
-  explicit OneButtonTiny(const int pin, const bool activeLow = true, const bool pullupActive = true);
-
-  /**
-   * set # millisec after safe click is assumed.
-   */
-  void setDebounceMs(const unsigned int ms);
-
-  /**
-   * set # millisec after single click is assumed.
-   */
-  void setClickMs(const unsigned int ms);
-
-  /**
-   * set # millisec after press is assumed.
-   */
-  void setPressMs(const unsigned int ms);
-
-  // ----- Attach events functions -----
-
-  /**
-   * Attach an event to be called when a single click is detected.
-   * @param newFunction This function will be called when the event has been detected.
-   */
-  void attachClick(callbackFunction newFunction);
-
-  /**
-   * Attach an event to be called after a double click is detected.
-   * @param newFunction This function will be called when the event has been detected.
-   */
-  void attachDoubleClick(callbackFunction newFunction);
-
-  /**
-   * Attach an event to be called after a multi click is detected.
-   * @param newFunction This function will be called when the event has been detected.
-   */
-  void attachMultiClick(callbackFunction newFunction);
-
-  /**
-   * Attach an event to fire when the button is pressed and held down.
-   * @param newFunction
-   */
-  void attachLongPressStart(callbackFunction newFunction);
-
-
-  // ----- State machine functions -----
-
-  /**
-   * @brief Call this function every some milliseconds for checking the input
-   * level at the initialized digital pin.
-   */
-  void tick(void);
-
-  /**
-   * @brief Call this function every time the input level has changed.
-   * Using this function no digital input pin is checked because the current
-   * level is given by the parameter.
-   * Run the finite state machine (FSM) using the given level.
-   */
-  void tick(bool level);
-
-
-  /**
-   * Reset the button state machine.
-   */
-  void reset(void);
-
-
-  /**
-   * @return true if we are currently handling button press flow
-   * (This allows power sensitive applications to know when it is safe to power down the main CPU)
-   */
-  bool isIdle() const {
-    return _state == OCS_INIT;
-  }
-
-
-private:
-  int _pin = -1;                   // hardware pin number.
-  unsigned int _debounce_ms = 50;  // number of msecs for debounce times.
-  unsigned int _click_ms = 400;    // number of msecs before a click is detected.
-  unsigned int _press_ms = 800;    // number of msecs before a long button press is detected
-
-  int _buttonPressed = 0;  // this is the level of the input pin when the button is pressed.
-                           // LOW if the button connects the input pin to GND when pressed.
-                           // HIGH if the button connects the input pin to VCC when pressed.
-
-  // These variables will hold functions acting as event source.
-  callbackFunction _clickFunc = NULL;
-  callbackFunction _doubleClickFunc = NULL;
-  callbackFunction _longPressStartFunc = NULL;
-
-  // These variables that hold information across the upcoming tick calls.
-  // They are initialized once on program start and are updated every time the
-  // tick function is called.
-
-  // define FiniteStateMachine
-  enum stateMachine_t : int {
-    OCS_INIT = 0,
-    OCS_DOWN = 1,  // button is down
-    OCS_UP = 2,    // button is up
-    OCS_COUNT = 3,
-    OCS_PRESS = 6,  // button is hold down
-    OCS_PRESSEND = 7,
-  };
-
-  /**
-   * Run the finite state machine (FSM) using the given level.
-   */
-  void _fsm(bool activeLevel);
-
-  /**
-   *  Advance to a new state.
-   */
-  void _newState(stateMachine_t nextState);
-
-  stateMachine_t _state = OCS_INIT;
-
-  int debouncedPinLevel = -1;
-  int _lastDebouncePinLevel = -1;       // used for pin debouncing
-  unsigned long _lastDebounceTime = 0;  // millis()
-  unsigned long now = 0;                // millis()
-
-  unsigned long _startTime = 0;  // start of current input change to checking debouncing
-  int _nClicks = 0;              // count the number of clicks with this variable
+typedef OneButtonT<OneButtonTinyConfig> OneButtonTiny;
 
-public:
-  int pin() const {
-    return _pin;
-  };
-  stateMachine_t state() const {
-    return _state;
-  };
-  int debounce(const int value);
-  int debouncedValue() const {
-    return debouncedPinLevel;
-  };
-};
+// The RAM budget of an instance on the 8-bit AVR and the 32-bit boards.
+#if defined(__AVR__)
+static_assert(sizeof(OneButtonTiny) <= 28, "OneButtonTiny exceeds its RAM budget.");
+#elif (__SIZEOF_POINTER__ == 4)
+static_assert(sizeof(OneButtonTiny) <= 36, "OneButtonTiny exceeds its RAM budget.");
+#endif
 
 #endif
@@ -0,0 +1,137 @@
+/**
+ * @file OneButtonTrace.cpp
+ *
+ * @brief Recording and reading the raw input levels of a button in a compact binary trace.
+ *
+ * @author Matthias Hertel, https://www.mathertel.de
+ * @Copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD style license. See
+ * http://www.mathertel.de/License.aspx
+ *
+ * More information on: https://www.mathertel.de/Arduino/OneButtonLibrary.aspx
+ *
+ * Changelog: see OneButtonTrace.h
+ */
+
+#include "OneButtonTrace.h"
+
+// ----- OneButtonTraceRecorder -----
+
+OneButtonTraceRecorder::OneButtonTraceRecorder(uint8_t *buffer, const uint16_t size) {
+  _buffer = buffer;
+  _size = size;
+}  // OneButtonTraceRecorder
+
+
+// start a new trace.
+void OneButtonTraceRecorder::begin(const bool level, const unsigned long ms) {
+  _length = 0;
+  _overflow = (_size < ONEBUTTONTRACE_HEADER);
+  if (_overflow) return;
+
+  _buffer[0] = 'O';
+  _buffer[1] = 'B';
+  _buffer[2] = ONEBUTTONTRACE_VERSION;
+  _buffer[3] = 0;
+  _length = ONEBUTTONTRACE_HEADER;
+
+  // the first record holds the level at the start.
+  _time = ms;
+  _level = !level;
+  _write(0, level);
+}  // begin()
+
+
+// record a level, only changes are stored.
+bool OneButtonTraceRecorder::record(const bool level, const unsigned long ms) {
+  if (_overflow) return false;
+  if (level == _level) return true;
+  if ((long)(ms - _time) < 0) return false;  // the time must not go backwards.
+  return _write(ms - _time, level);
+}  // record()
+
+
+// mark the end time and write the length.
+void OneButtonTraceRecorder::end(const unsigned long ms) {
+  if (_length < ONEBUTTONTRACE_HEADER) return;
+
+  // the end mark may be lost when the buffer is full.
+  if (!_overflow) {
+    _write(((long)(ms - _time) < 0) ? 0 : ms - _time, _level);
+  }
+
+  uint16_t len = _length - ONEBUTTONTRACE_HEADER;
+  _buffer[4] = len & 0xFF;
+  _buffer[5] = len >> 8;
+}  // end()
+
+
+/**
+ * @brief Write a record as a variable length number.
+ * The record is written completely or not at all.
+ */
+bool OneButtonTraceRecorder::_write(const unsigned long delta, const bool level) {
+  uint8_t tmp[(sizeof(delta) * 8 + 6) / 7];  // 6 bits in the first byte, 7 bits in the following bytes.
+  uint8_t n = 0;
+  unsigned long v = delta;
+
+  // the lowest bit holds the level.
+  tmp[n] = ((v & 0x3F) << 1) | (level ? 1 : 0);
+  v >>= 6;
+  while (v) {
+    tmp[n++] |= 0x80;
+    tmp[n] = v & 0x7F;
+    v >>= 7;
+  }
+  n++;
+
+  if ((uint16_t)(_size - _length) < n) {
+    _overflow = true;
+    return false;
+  }
+  for (uint8_t i = 0; i < n; i++) _buffer[_length++] = tmp[i];
+
+  _time += delta;
+  _level = level;
+  return true;
+}  // _write()
+
+
+// ----- OneButtonTraceReader -----
+
+OneButtonTraceReader::OneButtonTraceReader(const uint8_t *data, const size_t size) {
+  _data = data + ONEBUTTONTRACE_HEADER;
+
+  if ((size >= ONEBUTTONTRACE_HEADER) && (data[0] == 'O') && (data[1] == 'B') && (data[2] == ONEBUTTONTRACE_VERSION)) {
+    _length = data[4] | (data[5] << 8);
+    _valid = (size - ONEBUTTONTRACE_HEADER >= _length);
+  }
+}  // OneButtonTraceReader
+
+
+// read the next record.
+bool OneButtonTraceReader::next(bool &level, unsigned long &ms) {
+  if (!_valid || (_pos >= _length)) return false;
+
+  uint8_t b = _data[_pos++];
+  unsigned long delta = (b >> 1) & 0x3F;
+  uint8_t shift = 6;
+
+  level = b & 0x01;
+  while ((b & 0x80) && (_pos < _length)) {
+    b = _data[_pos++];
+    // bits beyond the width of delta are skipped.
+    if (shift < sizeof(delta) * 8) {
+      delta |= (unsigned long)(b & 0x7F) << shift;
+      shift += 7;
+    }
+  }
+
+  _time += delta;
+  ms = _time;
+  return true;
+}  // next()
+
+
+// end.
@@ -0,0 +1,147 @@
+// -----
+// OneButtonTrace.h - Recording and reading the raw input levels of a button
+// with their time in a compact binary trace.
+// This class is implemented for use with the Arduino environment.
+// Copyright (c) by Matthias Hertel, http://www.mathertel.de
+// This work is licensed under a BSD style license. See
+// http://www.mathertel.de/License.aspx More information on:
+// http://www.mathertel.de/Arduino
+// -----
+// A trace starts with a header of 6 bytes:
+//   'O', 'B', version (1), reserved (0), length of the records (16 bit, little endian).
+// Every record is a variable length number (7 bits per byte, lowest bits first,
+// bit 7 set when more bytes follow) holding (msecs since the previous record << 1) | level.
+// Only level changes are recorded, a record with an unchanged level marks the end of the trace.
+// Several traces can be stored one after the other in a file.
+// -----
+
+#ifndef OneButtonTrace_h
+#define OneButtonTrace_h
+
+#include "Arduino.h"
+
+#define ONEBUTTONTRACE_VERSION 1
+#define ONEBUTTONTRACE_HEADER 6
+
+
+class OneButtonTraceRecorder {
+public:
+  // ----- Constructor -----
+
+  /**
+   * Create a recorder using a given buffer for the trace.
+   * @param buffer The memory for the trace.
+   * @param size The size of the buffer in bytes, at least 6 bytes for the header.
+   */
+  OneButtonTraceRecorder(uint8_t *buffer, const uint16_t size);
+
+  // ----- Recording functions -----
+
+  /**
+   * Start a new trace at the current time.
+   * @param level The active level of the input at the start.
+   */
+  void begin(const bool level = false) {
+    begin(level, millis());
+  };
+  void begin(const bool level, const unsigned long ms);
+
+  /**
+   * Record the active level as passed to tick(bool) or debounce().
+   * Call this function with every sample, only the changes are stored.
+   * A change with a time before the previous record is not stored.
+   * @return false when the buffer is full and the trace is truncated or the time goes backwards.
+   */
+  bool record(const bool level) {
+    return record(level, millis());
+  };
+  bool record(const bool level, const unsigned long ms);
+
+  /**
+   * Finish the trace by marking the end time and writing the length into the header.
+   */
+  void end() {
+    end(millis());
+  };
+  void end(const unsigned long ms);
+
+  // ----- Trace access -----
+
+  /**
+   * @return The trace including the header.
+   */
+  const uint8_t *data() const {
+    return _buffer;
+  };
+
+  /**
+   * @return The number of bytes in the trace including the header.
+   */
+  uint16_t length() const {
+    return _length;
+  };
+
+  /**
+   * @return true when level changes were dropped because the buffer was full.
+   */
+  bool overflow() const {
+    return _overflow;
+  };
+
+private:
+  uint8_t *_buffer;
+  uint16_t _size;
+  uint16_t _length = 0;
+
+  bool _level = false;        // the last recorded level.
+  bool _overflow = false;     // a record did not fit into the buffer.
+  unsigned long _time = 0;    // the time of the last record.
+
+  bool _write(const unsigned long delta, const bool level);
+};
+
+
+class OneButtonTraceReader {
+public:
+  // ----- Constructor -----
+
+  /**
+   * Create a reader for a trace.
+   * @param data The trace including the header.
+   * @param size The number of available bytes, may include further traces.
+   */
+  OneButtonTraceReader(const uint8_t *data, const size_t size);
+
+  /**
+   * @return true when the header is valid and the records are available.
+   */
+  bool valid() const {
+    return _valid;
+  };
+
+  /**
+   * Read the next record.
+   * @param level Set to the active level starting at the time of the record.
+   * @param ms Set to the msecs of the record since the start of the trace.
+   * @return false at the end of the trace.
+   */
+  bool next(bool &level, unsigned long &ms);
+
+  /**
+   * @return The size of the trace in bytes including the header.
+   * The next trace in a file starts after these bytes.
+   */
+  size_t size() const {
+    return ONEBUTTONTRACE_HEADER + _length;
+  };
+
+private:
+  const uint8_t *_data;  // the records.
+  uint16_t _length = 0;  // the length of the records.
+  uint16_t _pos = 0;     // the position of the next record.
+  bool _valid = false;
+
+  unsigned long _time = 0;  // the time of the last record.
+};
+
+#endif